@@ -32,6 +32,8 @@ amrex::IntVect     CAMR::hydro_tile_size(AMREX_D_DECL(1024,16,16));
 amrex::IntVect     CAMR::hydro_tile_size(AMREX_D_DECL(1024,1024,1024));
 #endif
 
+int CAMR::riemann_type = CAMRConstants::riemann_twoshock;
+
 int CAMR::pstateVel = -1;
 int CAMR::pstateT = -1;
 int CAMR::pstateDia = -1;
@@ -46,6 +48,11 @@ amrex::Vector<amrex::AMRErrorTag> CAMR::errtags;
 amrex::Vector<std::string> CAMR::spec_names;
 
 amrex::Vector<int> CAMR::src_list;
+amrex::Vector<amrex::Vector<int>> CAMR::src_comps;
+
+#ifdef AMREX_USE_EB
+amrex::Vector<amrex::BoxArray> CAMR::eb_surface_grids;
+#endif
 
 // this will be reset upon restart
 amrex::Real CAMR::previousCPUTimeUsed = 0.0;
@@ -172,17 +179,75 @@ CAMR::read_params()
   if (cfl <= 0.0 || cfl > 1.0) {
     amrex::Error("Invalid CFL factor; must be between zero and one.");
   }
-  if ((do_mol == 1) && (cfl > 0.3)) {
-    amrex::Error("Invalid CFL factor; must be <= 0.3 when using MOL hydro");
+  if (do_mol == 1) {
+    if (mol_order == 2 && mol_stages < 2) {
+      amrex::Error("CAMR::mol_stages must be at least 2 for mol_order = 2");
+    }
+    if (mol_order == 3 && mol_stages != 3) {
+      amrex::Error("CAMR::mol_stages must be 3 for mol_order = 3");
+    }
+    if (mol_order != 2 && mol_order != 3) {
+      amrex::Error("CAMR::mol_order must be 2 or 3");
+    }
+    // The SSP coefficient of SSP-RK(s,2) is s-1, so the limit on a single
+    // forward Euler stage scales up with it
+    const int ssp_coef = (mol_order == 2) ? mol_stages - 1 : 1;
+    if (cfl > 0.3 * ssp_coef) {
+      amrex::Error("Invalid CFL factor; must be <= 0.3 times the SSP coefficient of the MOL scheme");
+    }
+    // The old sources enter every stage, so the stage coefficients must
+    // take a constant rate r to S^n + r dt
+    amrex::Real sweight = 0.0;
+    for (int k = 0; k < mol_stages; ++k) {
+      amrex::Real alpha, beta, c, weight;
+      mol_stage_coeffs(k, alpha, beta, c, weight);
+      sweight = (1.0 - alpha) * (sweight + beta);
+    }
+    if (std::abs(sweight - 1.0) > 1.e-12) {
+      amrex::Error("CAMR::mol_stage_coeffs are not consistent for a constant source");
+    }
+  }
+  if (use_retry && max_subcycles < 2) {
+    amrex::Error("CAMR::max_subcycles must be at least 2 with use_retry");
+  }
+  if (local_time_stepping && use_retry) {
+    amrex::Error("CAMR::use_retry cannot be used with local_time_stepping");
+  }
+  // The Godunov predictor uses the dt of the tile, so two tiles sharing a
+  // face would compute different fluxes on it
+  if (local_time_stepping && !do_mol) {
+    amrex::Error("CAMR::local_time_stepping requires do_mol = 1");
+  }
+  if (adaptive_regrid && regrid_travel_frac <= 0.0) {
+    amrex::Error("CAMR::regrid_travel_frac must be positive");
   }
 
   // Check on PPM type
   if (do_mol == 0) {
-    if (ppm_type != 0 && ppm_type != 1) {
-      amrex::Error("CAMR::ppm_type must be 0 (PLM) or 1 (PPM)");
+    if (ppm_type != 0 && ppm_type != 1 && ppm_type != 2) {
+      amrex::Error("CAMR::ppm_type must be 0 (PLM), 1 (PPM) or 2 (hybrid)");
+    }
+  }
+  if (godunov_split) {
+#ifdef AMREX_USE_EB
+    // CAMR_umdrv_eb has no split sweeps and is never given sweep_order
+    amrex::Error("CAMR::godunov_split is not supported with EB");
+#endif
+    if (AMREX_SPACEDIM != 3) {
+      amrex::Error("CAMR::godunov_split is only available in 3D");
     }
   }
 
+  if (riemann_solver == "twoshock") {
+      riemann_type = CAMRConstants::riemann_twoshock;
+  } else if (riemann_solver == "hll") {
+      riemann_type = CAMRConstants::riemann_hll;
+  } else if (riemann_solver == "hllc") {
+      riemann_type = CAMRConstants::riemann_hllc;
+  } else {
+      amrex::Error("Must set riemann_solver to twoshock, hll, or hllc");
+  }
+
 #ifdef AMREX_USE_EB
   if (do_mol == 0) {
       amrex::Warning("EBGodunov is still a WIP");
@@ -225,6 +290,14 @@ CAMR::read_params()
       if (local_bf < 8) amrex::Error("Blocking factor must be at least 8 for EB");
   }
 #endif
+
+  // Refluxing adds level-dt flux differences to cells that advance at their
+  // own pseudo-timestep, which moves the converged composite solution
+  int amr_max_level = 0;
+  ppa.query("max_level", amr_max_level);
+  if (local_time_stepping && do_reflux && amr_max_level > 0) {
+    amrex::Error("CAMR::local_time_stepping cannot be used with refluxing on more than one level");
+  }
 }
 
 CAMR::CAMR()
@@ -260,20 +333,17 @@ CAMR::init_stuff(amrex::Amr& papa,
     int oldGrow = numGrow();
     int newGrow = S_new.nGrow();
 
+    // Only the active sources are stored, each with the components it writes
     for (int n = 0; n < src_list.size(); ++n) {
+      const int ncomp = static_cast<int>(src_comps[src_list[n]].size());
       old_sources[src_list[n]] = std::make_unique<amrex::MultiFab>(
-        grids, dmap, NVAR, oldGrow, amrex::MFInfo(), Factory());
+        grids, dmap, ncomp, oldGrow, amrex::MFInfo(), Factory());
       new_sources[src_list[n]] = std::make_unique<amrex::MultiFab>(
-        grids, dmap, NVAR, newGrow, amrex::MFInfo(), Factory());
+        grids, dmap, ncomp, newGrow, amrex::MFInfo(), Factory());
     }
 
     Sborder.define(grids, dmap, NVAR, numGrow(), amrex::MFInfo(), Factory());
 
-    hydro_source.define(grids, dmap, NVAR, numGrow(), amrex::MFInfo(), Factory());
-    if (do_mol) {
-        new_hydro_source.define(grids, dmap, NVAR, numGrow(), amrex::MFInfo(), Factory());
-    }
-
     // This array holds the sum of all source terms that affect the
     // hydrodynamics. If we are doing the source term predictor, we'll also
     // use this after the hydro update to store the sum of the new-time
@@ -331,21 +401,74 @@ CAMR::buildMetrics()
                          CAMRConstants::level_mask_physbnd,
                          CAMRConstants::level_mask_interior);
 
+    buildEBTileInfo();
 #endif
 
-  volume.clear();
-  volume.define(
-    grids, dmap, 1, numGrow(), amrex::MFInfo(), amrex::FArrayBoxFactory());
-  geom.GetVolume(volume);
+  // Cell volumes and face areas are not stored: with Cartesian coordinates
+  // they are constants, see Volume() and Area().
+}
+
+#ifdef AMREX_USE_EB
+void
+CAMR::buildEBTileInfo()
+{
+  BL_PROFILE("CAMR::buildEBTileInfo()");
 
-  for (int dir = 0; dir < AMREX_SPACEDIM; dir++) {
-    area[dir].clear();
-    area[dir].define(
-      getEdgeBoxArray(dir), dmap, 1, numGrow(), amrex::MFInfo(),
-      amrex::FArrayBoxFactory());
-    geom.GetFaceArea(area[dir], dir);
+  const auto& flags = EBFactory().getMultiEBCellFlagFab();
+  const int ngrow_bx = eb_redist_ngrow();
+  const bool split = (eb_split_tile_size > 0) && amrex::TilingIfNotGPU();
+
+  // Must match the tiling used in construct_hydro_source
+  const amrex::MFItInfo tiling = hydroTiling();
+
+  const amrex::StateDescriptor& desc = desc_lst[State_Type];
+  const auto& bcs = desc.getBCs();
+  eb_bcs_d.resize(desc.nComp());
+  amrex::Gpu::copy(
+    amrex::Gpu::hostToDevice, bcs.begin(), bcs.end(), eb_bcs_d.begin());
+
+  eb_tile_info.clear();
+  for (amrex::MFIter mfi(*volfrac, tiling); mfi.isValid(); ++mfi) {
+    if (eb_tile_info.empty()) {
+      eb_tile_info.resize(mfi.length());
+    }
+    const amrex::Box& bx = mfi.tilebox();
+    const amrex::EBCellFlagFab& flagfab = flags[mfi];
+    EBTileInfo& info = eb_tile_info[mfi.LocalTileIndex()];
+    info.flag = flagfab.const_array();
+    info.vfrac = volfrac->const_array(mfi);
+
+    if (flagfab.getType(bx) == amrex::FabType::covered) {
+      info.type = amrex::FabType::covered;
+      continue;
+    }
+    info.type = flagfab.getType(amrex::grow(bx, ngrow_bx));
+    if (info.type == amrex::FabType::regular) {
+      continue;
+    }
+
+    amrex::BoxList sub_boxes(bx);
+    if (split) {
+      sub_boxes.maxSize(eb_split_tile_size);
+    }
+    for (const amrex::Box& sbx : sub_boxes) {
+      if (flagfab.getType(amrex::grow(sbx, ngrow_bx)) == amrex::FabType::regular) {
+        info.regular_boxes.push_back(sbx);
+      } else if (flagfab.getType(sbx) != amrex::FabType::covered) {
+        info.cut_boxes.push_back(sbx);
+      }
+    }
+
+    if (!info.cut_boxes.empty()) {
+      info.ccent = EBFactory().getCentroid().const_array(mfi);
+      for (int dir = 0; dir < AMREX_SPACEDIM; ++dir) {
+        info.apert[dir] = areafrac[dir]->const_array(mfi);
+        info.fcent[dir] = facecent[dir]->const_array(mfi);
+      }
+    }
   }
 }
+#endif
 
 void
 CAMR::setTimeLevel(amrex::Real time, amrex::Real dt_old, amrex::Real dt_new)
@@ -444,9 +567,91 @@ CAMR::init(AmrLevel& old)
 
   setTimeLevel(cur_time, dt_old, dt_new);
 
+  // Keep measuring the residual drop against the same reference
+  residual_ref = oldlev->residual_ref;
+
+  // Boxes that are in both the old and the new grids and stay on the same
+  // rank are copied straight from the old level. FillPatch, with its
+  // interpolation and communication, only runs on the remaining boxes.
+  const amrex::BoxArray& old_grids = oldlev->grids;
+  const amrex::DistributionMapping& old_dmap = oldlev->dmap;
+
+  amrex::Vector<int> old_index(grids.size(), -1);
+  amrex::BoxList fill_bl;
+  amrex::Vector<int> fill_pmap;
+  for (int i = 0; i < grids.size(); ++i) {
+    for (const auto& is : old_grids.intersections(grids[i])) {
+      if (old_grids[is.first] == grids[i] && old_dmap[is.first] == dmap[i]) {
+        old_index[i] = is.first;
+        break;
+      }
+    }
+    if (old_index[i] < 0) {
+      fill_bl.push_back(grids[i]);
+      fill_pmap.push_back(dmap[i]);
+    }
+  }
+  const int nreused = grids.size() - static_cast<int>(fill_pmap.size());
+
+  if (verbose > 0) {
+    amrex::Print() << "Regrid level " << level << ": reusing " << nreused
+                   << " of " << grids.size() << " boxes" << std::endl;
+  }
+
+  // The new regions live on the same ranks as in the new layout, so the
+  // result is copied in without communication. Their layout and factory
+  // are shared by all state types.
+  amrex::BoxArray fill_ba;
+  amrex::DistributionMapping fill_dm;
+  std::unique_ptr<amrex::FabFactory<amrex::FArrayBox>> fill_factory;
+  if (nreused > 0 && !fill_pmap.empty()) {
+    fill_ba = amrex::BoxArray(fill_bl);
+    fill_dm = amrex::DistributionMapping(fill_pmap);
+#ifdef AMREX_USE_EB
+    fill_factory = amrex::makeEBFabFactory(
+      geom, fill_ba, fill_dm,
+      {m_eb_basic_grow_cells, m_eb_volume_grow_cells, m_eb_full_grow_cells},
+      m_eb_support_level);
+#else
+    fill_factory = std::make_unique<amrex::FArrayBoxFactory>();
+#endif
+  }
+
   for (int s = 0; s < num_state_type; ++s) {
      amrex::MultiFab& state_MF = get_new_data(s);
-     FillPatch(old, state_MF, state_MF.nGrow(), cur_time, s, 0, state_MF.nComp());
+
+     // Ghost cells of reused boxes would still need a fill, so states that
+     // carry ghost cells take the plain path
+     if (nreused == 0 || state_MF.nGrow() > 0) {
+       FillPatch(old, state_MF, state_MF.nGrow(), cur_time, s, 0, state_MF.nComp());
+       continue;
+     }
+
+     const amrex::MultiFab& old_MF = oldlev->get_new_data(s);
+     const int ncomp = state_MF.nComp();
+#ifdef _OPENMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+     for (amrex::MFIter mfi(state_MF, amrex::TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+       const int j = old_index[mfi.index()];
+       if (j < 0) {
+         continue;
+       }
+       const amrex::Box& bx = mfi.tilebox();
+       auto const& dst = state_MF.array(mfi);
+       auto const& src = old_MF.const_array(j);
+       amrex::ParallelFor(bx, ncomp, [=] AMREX_GPU_DEVICE(int i, int jj, int k, int n) noexcept {
+         dst(i, jj, k, n) = src(i, jj, k, n);
+       });
+     }
+
+     if (fill_pmap.empty()) {
+       continue;
+     }
+
+     amrex::MultiFab fill_MF(fill_ba, fill_dm, ncomp, 0, amrex::MFInfo(), *fill_factory);
+     FillPatch(old, fill_MF, 0, cur_time, s, 0, ncomp);
+     state_MF.ParallelCopy(fill_MF, 0, 0, ncomp);
   }
 }
 
@@ -498,8 +703,6 @@ amrex::Real CAMR::estTimeStep(amrex::Real /*dt_old*/)
 
   const amrex::MultiFab& stateMF = get_new_data(State_Type);
 
-  const auto& dx = geom.CellSizeArray();
-
   std::string limiter = "CAMR.max_dt";
 
   // Start the hydro with the max_dt value, but divide by CFL
@@ -510,16 +713,50 @@ amrex::Real CAMR::estTimeStep(amrex::Real /*dt_old*/)
   const amrex::Real max_dt_over_cfl = max_dt / cfl;
   amrex::Real estdt_hydro = max_dt_over_cfl;
 
+    const amrex::Real dt = signalCrossingTime(stateMF);
+
+    // Fastest signal speed in cells per unit time, without the max_dt cap
+    max_signal_rate = 1.0 / dt;
+
+    estdt_hydro = std::min(estdt_hydro, dt);
+    estdt_hydro *= cfl;
+
+    if (verbose) {
+      amrex::Print() << "...estimated hydro-limited timestep at level " << level
+                     << ": " << estdt_hydro << " -> " << estdt_hydro*std::pow(2, level) << std::endl;
+    }
+
+    // Determine if this is more restrictive than the maximum timestep limiting
+    if (estdt_hydro < estdt) {
+      limiter = "hydro";
+      estdt = estdt_hydro;
+    }
+
+  if (verbose) {
+    amrex::Print() << "CAMR::estTimeStep (" << limiter << "-limited) at level "
+                   << level << ":  estdt = " << estdt << '\n';
+  }
+
+  return estdt;
+}
+
+amrex::Real
+CAMR::signalCrossingTime(const amrex::MultiFab& S) const
+{
+  // Shortest time for a hydrodynamic wave to cross a cell anywhere on S
+
+  const auto& dx = geom.CellSizeArray();
+
 #ifdef AMREX_USE_EB
     auto const& fact =
-      dynamic_cast<amrex::EBFArrayBoxFactory const&>(stateMF.Factory());
+      dynamic_cast<amrex::EBFArrayBoxFactory const&>(S.Factory());
     auto const& flags = fact.getMultiEBCellFlagFab();
 #endif
 
     amrex::Real AMREX_D_DECL(dx1 = dx[0], dx2 = dx[1], dx3 = dx[2]);
 
 #ifdef AMREX_USE_EB
-    amrex::Real dt = amrex::ReduceMin( stateMF, flags, 0,
+    amrex::Real dt = amrex::ReduceMin( S, flags, 0,
         [=] AMREX_GPU_HOST_DEVICE(
           amrex::Box const& bx, const amrex::Array4<const amrex::Real>& fab_arr,
           const amrex::Array4<const amrex::EBCellFlag>& flag_arr
@@ -529,7 +766,7 @@ amrex::Real CAMR::estTimeStep(amrex::Real /*dt_old*/)
             AMREX_D_DECL(dx1, dx2, dx3));
         });
 #else
-    amrex::Real dt = amrex::ReduceMin( stateMF, 0,
+    amrex::Real dt = amrex::ReduceMin( S, 0,
         [=] AMREX_GPU_HOST_DEVICE(
           amrex::Box const& bx, const amrex::Array4<const amrex::Real>& fab_arr
           ) -> amrex::Real {
@@ -537,28 +774,9 @@ amrex::Real CAMR::estTimeStep(amrex::Real /*dt_old*/)
         });
 #endif
 
-    estdt_hydro = std::min(estdt_hydro, dt);
-
-    amrex::ParallelDescriptor::ReduceRealMin(estdt_hydro);
-    estdt_hydro *= cfl;
-
-    if (verbose) {
-      amrex::Print() << "...estimated hydro-limited timestep at level " << level
-                     << ": " << estdt_hydro << " -> " << estdt_hydro*std::pow(2, level) << std::endl;
-    }
-
-    // Determine if this is more restrictive than the maximum timestep limiting
-    if (estdt_hydro < estdt) {
-      limiter = "hydro";
-      estdt = estdt_hydro;
-    }
-
-  if (verbose) {
-    amrex::Print() << "CAMR::estTimeStep (" << limiter << "-limited) at level "
-                   << level << ":  estdt = " << estdt << '\n';
-  }
+    amrex::ParallelDescriptor::ReduceRealMin(dt);
 
-  return estdt;
+    return dt;
 }
 
 void
@@ -697,6 +915,8 @@ CAMR::post_timestep(int /*iteration*/)
     amrex::MultiFab& S_new_crse = get_new_data(State_Type);
     clean_state(S_new_crse);
 
+    regrid_travel += parent->dtLevel(level) * max_signal_rate;
+
   if (level == 0) {
     int nstep = parent->levelSteps(0);
     amrex::Real dtlev = parent->dtLevel(0);
@@ -741,11 +961,38 @@ CAMR::postCoarseTimeStep(amrex::Real cumtime)
   AmrLevel::postCoarseTimeStep(cumtime);
 }
 
+bool
+CAMR::okToRegrid()
+{
+  if (!adaptive_regrid || max_signal_rate <= 0.0) {
+    return true;
+  }
+
+  int nbuf = parent->nErrorBuf(level, 0);
+  for (int dir = 1; dir < AMREX_SPACEDIM; ++dir) {
+    nbuf = std::min(nbuf, parent->nErrorBuf(level, dir));
+  }
+
+  const bool ok = regrid_travel >= regrid_travel_frac * nbuf;
+  if (verbose > 0 && !ok) {
+    amrex::Print() << "Skipping regrid at level " << level << ": features moved at most "
+                   << regrid_travel << " of " << nbuf << " buffer cells" << std::endl;
+  }
+  return ok;
+}
+
 void
-CAMR::post_regrid(int /*lbase*/, int /*new_finest*/)
+CAMR::post_regrid(int lbase, int /*new_finest*/)
 {
   BL_PROFILE("CAMR::post_regrid()");
   fine_mask.clear();
+  if (level >= lbase) {
+    regrid_travel = 0.0;
+  }
+  hydro_fine_grids = amrex::BoxArray();
+  hydro_work_boxes.clear();
+  quiescent_nbrs.clear();
+  tile_changed.clear();
 }
 
 void CAMR::post_init(amrex::Real /*stop_time*/)
@@ -819,6 +1066,19 @@ CAMR::okToContinue()
 
     amrex::Print() << " Signalling a stop of the run because dt < dt_cutoff."
                    << std::endl;
+  } else if (steady_tol > 0.0) {
+    bool converged = true;
+    for (int lev = 0; lev <= parent->finestLevel(); ++lev) {
+      const CAMR& camr_lev = getLevel(lev);
+      converged = converged && camr_lev.have_residual &&
+        camr_lev.residual_norm[1] <= steady_tol * camr_lev.residual_ref;
+    }
+    if (converged) {
+      test = 0;
+
+      amrex::Print() << " Signalling a stop of the run because the residual "
+                     << "dropped below steady_tol." << std::endl;
+    }
   }
 
   return test;
@@ -851,8 +1111,7 @@ CAMR::reflux()
 
   if (!amrex::DefaultGeometry().IsCartesian()) {
     amrex::MultiFab dr(
-      volume.boxArray(), volume.DistributionMap(), 1, volume.nGrow(),
-      amrex::MFInfo(), amrex::FArrayBoxFactory());
+      grids, dmap, 1, numGrow(), amrex::MFInfo(), amrex::FArrayBoxFactory());
     dr.setVal(geom.CellSizeArray()[0]);
     amrex::Abort("CAMR reflux not yet ready for r-z");
   }
@@ -1046,7 +1305,7 @@ CAMR::enforce_min_density(amrex::MultiFab& S_new)
                 // We could not find any nearby zones with sufficient density.
                 // This used to be called "reset_to_small_state"
                 amrex::Real small_e;
-                amrex::Real massfrac[NUM_SPECIES];
+                amrex::Real massfrac[NUM_SPECIES_ARR];
                 for (int is = 0; is < NUM_SPECIES; is++) {
                     massfrac[is] = Sarr(i,j,k,UFS+is) / Sarr(i,j,k,URHO);
                 }
@@ -1200,7 +1459,7 @@ CAMR::computeTemp(amrex::MultiFab& S, int ng)
        amrex::Real rhoInv = 1.0 / Sarr(i, j, k, URHO);
        amrex::Real T = Sarr(i, j, k, UTEMP);
        amrex::Real e = Sarr(i, j, k, UEINT) * rhoInv;
-       amrex::Real massfrac[NUM_SPECIES];
+       amrex::Real massfrac[NUM_SPECIES_ARR];
        for (int n = 0; n < NUM_SPECIES; ++n) {
          massfrac[n] = Sarr(i, j, k, UFS + n) * rhoInv;
        }
@@ -1267,6 +1526,95 @@ CAMR::build_fine_mask()
   return fine_mask;
 }
 
+void
+CAMR::buildHydroWorkBoxes()
+{
+  BL_PROFILE("CAMR::buildHydroWorkBoxes()");
+
+  AMREX_ASSERT(level < parent->finestLevel());
+
+  hydro_fine_grids = parent->boxArray(level + 1);
+
+  // Coarse cells further than nhalo from any uncovered cell are left alone.
+  // The fine ghost cell interpolation reaches one coarse cell under the fine
+  // grids, the second MOL stage reads the stage-one state over the full
+  // stencil, and the EB redistribution moves mass over its own neighborhood.
+  int nhalo = do_mol ? numGrow() : 1;
+#ifdef AMREX_USE_EB
+  nhalo += eb_redist_ngrow();
+#endif
+
+  amrex::BoxArray covered = hydro_fine_grids;
+  covered.coarsen(parent->refRatio(level));
+
+  // Cells outside the domain count as uncovered, which keeps the interior
+  // away from physical and periodic boundaries
+  const amrex::Box& domain = geom.Domain();
+  amrex::BoxList uncovered;
+  uncovered.complementIn(amrex::grow(domain, nhalo), covered);
+  uncovered.accrete(nhalo);
+  amrex::BoxList interior_bl;
+  interior_bl.complementIn(domain, amrex::BoxArray(std::move(uncovered)));
+  const amrex::BoxArray interior(std::move(interior_bl));
+
+  // Must match the tiling used in construct_hydro_source
+  const amrex::MFItInfo tiling = hydroTiling();
+
+  hydro_work_boxes.clear();
+  for (amrex::MFIter mfi(get_new_data(State_Type), tiling); mfi.isValid(); ++mfi) {
+    if (hydro_work_boxes.empty()) {
+      hydro_work_boxes.resize(mfi.length());
+    }
+    const amrex::Box& bx = mfi.tilebox();
+    amrex::Vector<amrex::Box>& work = hydro_work_boxes[mfi.LocalTileIndex()];
+    if (!interior.intersects(bx)) {
+      work.push_back(bx);
+      continue;
+    }
+    amrex::BoxList bl;
+    bl.complementIn(bx, interior);
+    for (const amrex::Box& b : bl) {
+      work.push_back(b);
+    }
+  }
+}
+
+void
+CAMR::buildQuiescentNbrs()
+{
+  BL_PROFILE("CAMR::buildQuiescentNbrs()");
+
+  // Must match the tiling used in construct_hydro_source
+  const amrex::MFItInfo tiling = hydroTiling();
+  const amrex::MultiFab& S_new = get_new_data(State_Type);
+
+  amrex::Vector<amrex::Box> tile_boxes;
+  for (amrex::MFIter mfi(S_new, tiling); mfi.isValid(); ++mfi) {
+    if (tile_boxes.empty()) {
+      tile_boxes.resize(mfi.length());
+    }
+    tile_boxes[mfi.LocalTileIndex()] = mfi.tilebox();
+  }
+  const amrex::BoxArray tiles(amrex::BoxList(std::move(tile_boxes)));
+
+  // The tiles are disjoint, so the stencil is covered by local tiles when
+  // their intersections with it add up to its size
+  quiescent_nbrs.clear();
+  quiescent_nbrs.resize(tiles.size());
+  for (amrex::MFIter mfi(S_new, tiling); mfi.isValid(); ++mfi) {
+    const amrex::Box& qbx = amrex::grow(mfi.tilebox(), numGrow());
+    amrex::Vector<int>& nbrs = quiescent_nbrs[mfi.LocalTileIndex()];
+    amrex::Long npts = 0;
+    for (const auto& is : tiles.intersections(qbx)) {
+      nbrs.push_back(is.first);
+      npts += is.second.numPts();
+    }
+    if (npts != qbx.numPts()) {
+      nbrs.clear();
+    }
+  }
+}
+
 void
 CAMR::expand_state(amrex::MultiFab& S, const amrex::Real time, const int ng)
 {
@@ -2,6 +2,7 @@
 #include "IndexDefines.H"
 
 #include <cmath>
+#include <string>
 
 using std::string;
 
@@ -82,12 +83,87 @@ CAMR::CAMR_advance (Real time,
 
     clean_state(get_old_data(State_Type));
 
-    MultiFab& S_old = get_old_data(State_Type);
-    amrex::ignore_unused(S_old);
+    // With retries the old state and this level's fine-side flux register
+    // data are kept, so that a failed step can be undone
+    MultiFab S_prev;
+    MultiFab flux_reg_prev;
+    if (use_retry) {
+        const MultiFab& S_old = get_old_data(State_Type);
+        S_prev.define(grids, dmap, NVAR, S_old.nGrow(), amrex::MFInfo(), Factory());
+        MultiFab::Copy(S_prev, S_old, 0, 0, NVAR, S_old.nGrow());
+        if (do_reflux && level > 0) {
+            const MultiFab& fine_data = getFluxReg(level).getFineData();
+            flux_reg_prev.define(fine_data.boxArray(), fine_data.DistributionMap(),
+                                 fine_data.nComp(), fine_data.nGrow());
+            MultiFab::Copy(flux_reg_prev, fine_data, 0, 0, fine_data.nComp(), fine_data.nGrow());
+        }
+    }
 
-    MultiFab& S_new = get_new_data(State_Type);
+    int nsub = do_advance(time, dt);
+
+    // Redo a failed step as nsub equal substeps, refining further if one of
+    // them fails too
+    while (nsub > 1) {
+        if (nsub > max_subcycles) {
+            amrex::Abort("CAMR::CAMR_advance: retry needs " + std::to_string(nsub) +
+                         " subcycles, more than CAMR.max_subcycles");
+        }
+        amrex::Print() << "Retrying the step at level " << level << " with "
+                       << nsub << " subcycles" << std::endl;
+
+        if (do_reflux && level < finest_level) {
+            getFluxReg(level + 1).reset();
+        }
+        // The substeps start over from the old state, which the quiescent
+        // tile marks of the failed step do not describe
+        tile_changed.clear();
+        if (do_reflux && level > 0) {
+            MultiFab& fine_data = getFluxReg(level).getFineData();
+            MultiFab::Copy(fine_data, flux_reg_prev, 0, 0, fine_data.nComp(), fine_data.nGrow());
+        }
+
+        const Real dt_sub = dt / nsub;
+        int nsub_next = 1;
+        for (int isub = 0; isub < nsub; ++isub) {
+            MultiFab& S_old = get_old_data(State_Type);
+            const MultiFab& S_from = (isub == 0) ? S_prev : get_new_data(State_Type);
+            MultiFab::Copy(S_old, S_from, 0, 0, NVAR, S_old.nGrow());
+            setTimeLevel(time + (isub + 1) * dt_sub, dt_sub, dt_sub);
+
+            const int n = do_advance(time + isub * dt_sub, dt_sub);
+            if (n > 1) {
+                nsub_next = nsub * std::max(n, 2);
+                break;
+            }
+        }
+
+        MultiFab::Copy(get_old_data(State_Type), S_prev, 0, 0, NVAR, S_prev.nGrow());
+        setTimeLevel(time + dt, dt, dt);
+        nsub = nsub_next;
+    }
+
+    Sborder.clear();
+    Sborder.define(grids, dmap, NVAR, numGrow(), amrex::MFInfo(), Factory());
+
+    if (do_react) {
+        react(get_new_data(State_Type));
+    }
+
+    return dt_new;
+}
+
+int
+CAMR::do_advance (Real time, Real dt)
+{
+  // Take one step of size dt from the old to the new state data. With
+  // use_retry, the hydro update is checked before the state is cleaned up,
+  // and the number of substeps needed to redo the step is returned (1 if
+  // the step is good).
 
-    // Do the advance.
+    BL_PROFILE("CAMR::do_advance()");
+
+    MultiFab& S_old = get_old_data(State_Type);
+    MultiFab& S_new = get_new_data(State_Type);
 
     const Real prev_time = state[State_Type].prevTime();
     const Real  cur_time = state[State_Type].curTime();
@@ -102,63 +178,210 @@ CAMR::CAMR_advance (Real time,
       react(Sborder);
     }
 
-    // Initialize all forces to zero
-    for (int n = 0; n < src_list.size(); ++n) {
-        old_sources[src_list[n]]->setVal(0.0);
-        new_sources[src_list[n]]->setVal(0.0);
+    // The valid cells of the new-time data are written by the stage update
+    // in construct_hydro_source; only ghost cells need the copy
+    if (S_new.nGrow() > 0) {
+        MultiFab::Copy(S_new, Sborder, 0, 0, NVAR, S_new.nGrow());
     }
 
-    // Initialize the new-time data.
-    MultiFab::Copy(S_new, Sborder, 0, 0, NVAR, S_new.nGrow());
-
-    // Build sources at t_old, then add them to S_new
+    // Build sources at t_old; every stage update adds them to S_new
     for (int n = 0; n < src_list.size(); ++n) {
         construct_old_source(src_list[n], time, dt);
-        MultiFab::Saxpy(S_new, dt, *old_sources[src_list[n]], 0, 0, NVAR, 0);
     }
 
-    sources_for_hydro.setVal(0.0);
+    // Only the components some source writes are ever nonzero
+    for (int n = 0; n < src_list.size(); ++n) {
+        for (int comp : src_comps[src_list[n]]) {
+            sources_for_hydro.setVal(0.0, comp, 1, sources_for_hydro.nGrow());
+        }
+    }
     //
     // Now build and add the hydro source term(s) to S_new
     //
     if (do_mol) {
-        construct_hydro_source(Sborder, hydro_source, time, dt);
-
-        // S^{n+1,*} = S^n + dt * dSdt^{n}
-        MultiFab::Saxpy(S_new, dt, hydro_source, 0, 0, NVAR, 0);
-
-        expand_state(Sborder, cur_time, numGrow());
-        construct_hydro_source(Sborder, new_hydro_source, cur_time, dt);
-
-        // S^{n+1} = 0.5 * (S^{n} + S^{n+1,*}) + 0.5 * dt * dSdt^{n+1,*}
-        MultiFab::LinComb(S_new, 0.5, Sborder, 0, 0.5, S_old, 0, 0, NVAR, 0);
-        MultiFab::Saxpy  (S_new, 0.5*dt, new_hydro_source, 0, 0, NVAR, 0);
+        // Low-storage SSP Runge-Kutta in Shu-Osher form, with S_old and
+        // S_new as the only registers:
+        //   S^(k) = alpha_k S^n + (1 - alpha_k) (S^(k-1) + beta_k dt L(S^(k-1)))
+        // with alpha_0 = 0. L includes the old sources, which the scheme thus
+        // applies with a total weight of dt.
+        for (int k = 0; k < mol_stages; ++k) {
+            Real alpha, beta, c, weight;
+            mol_stage_coeffs(k, alpha, beta, c, weight);
+
+            if (k > 0) {
+                // The next stage would fail in ctoprim on a bad stage state
+                if (use_retry) {
+                    const int nsub = retrySubcycles(S_old, S_new, dt);
+                    if (nsub > 1) {
+                        state[State_Type].setNewTimeLevel(cur_time);
+                        return nsub;
+                    }
+                }
+
+                // The stage state is the new data at the stage time, so
+                // the fill copies it and interpolates only coarse ghosts
+                state[State_Type].setNewTimeLevel(time + c * dt);
+                expand_state(Sborder, time + c * dt, numGrow());
+            }
+
+            construct_hydro_source(Sborder, S_new, time + c * dt, dt,
+                                   alpha, beta, (k == 0), weight);
+        }
+        state[State_Type].setNewTimeLevel(cur_time);
 
     } else {
-        construct_hydro_source(Sborder, hydro_source, time, dt);
-
-        // S^{n+1} = S^n + dt * dSdt^{n+1/2}
-        MultiFab::Saxpy(S_new, dt, hydro_source, 0, 0, NVAR, 0);
+        // S^{n+1} = S^n + dt * (dSdt^{n+1/2} + old sources)
+        construct_hydro_source(Sborder, S_new, time, dt, 0.0, 1.0, 1, 1.0);
+    }
 
+    if (use_retry) {
+        const int nsub = retrySubcycles(S_old, S_new, dt);
+        if (nsub > 1) {
+            return nsub;
+        }
     }
 
     // Sync up state after old sources and hydro source.
     clean_state(S_new);
 
 
-    // "new source" is actually the correction to the old source we've already added
-    for (int n = 0; n < src_list.size(); ++n) {
-        construct_new_source(src_list[n], time, dt);
-        MultiFab::Saxpy(S_new, dt, *new_sources[src_list[n]], 0, 0, NVAR, 0);
+    // "new source" is actually the correction to the old source we've already
+    // added. All corrections are evaluated from the same state and added in
+    // one pass.
+    if (!src_list.empty()) {
+        for (int n = 0; n < src_list.size(); ++n) {
+            construct_new_source(src_list[n], time, dt);
+        }
+        add_new_sources(S_new, dt);
         clean_state(S_new);
     }
 
-    Sborder.clear();
-    Sborder.define(grids, dmap, NVAR, numGrow(), amrex::MFInfo(), Factory());
+    return 1;
+}
 
-    if (do_react) {
-        react(S_new);
+void
+CAMR::add_new_sources (MultiFab& S_new, Real dt)
+{
+    BL_PROFILE("CAMR::add_new_sources()");
+
+    const int nsrc = static_cast<int>(src_list.size());
+    GpuArray<GpuArray<int, NVAR>, num_src> slots;
+    for (int n = 0; n < nsrc; ++n) {
+        slots[n] = src_slots(src_list[n]);
     }
 
-    return dt_new;
+    // With local time stepping each tile corrects with the pseudo-timestep
+    // its old sources were applied with
+#ifdef _OPENMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+    for (MFIter mfi(S_new, hydroTiling()); mfi.isValid(); ++mfi) {
+        const Box& bx = mfi.tilebox();
+        const Real dt_tile = (local_time_stepping) ? lts_tile_dt[mfi.LocalTileIndex()] : dt;
+        auto const& snew = S_new.array(mfi);
+        GpuArray<Array4<const Real>, num_src> srcs;
+        for (int n = 0; n < nsrc; ++n) {
+            srcs[n] = new_sources[src_list[n]]->const_array(mfi);
+        }
+        ParallelFor(bx, NVAR, [=] AMREX_GPU_DEVICE(int i, int j, int k, int n) noexcept {
+            Real rhs = 0.0;
+            for (int m = 0; m < nsrc; ++m) {
+                if (slots[m][n] >= 0) {
+                    rhs += srcs[m](i, j, k, slots[m][n]);
+                }
+            }
+            snew(i, j, k, n) += dt_tile * rhs;
+        });
+    }
+}
+
+void
+CAMR::mol_stage_coeffs (int k, Real& alpha, Real& beta, Real& c, Real& weight)
+{
+  // Shu-Osher coefficients of stage k of the MOL scheme (see do_advance),
+  // the stage time as a fraction c of dt, and the weight of the stage
+  // fluxes in the whole step, which is what the flux registers need.
+
+    if (mol_order == 3) {
+        // SSP-RK(3,3)
+        const Real a[3] = {0.0, 0.75, 1.0/3.0};
+        const Real t[3] = {0.0, 1.0, 0.5};
+        const Real w[3] = {1.0/6.0, 1.0/6.0, 2.0/3.0};
+        alpha  = a[k];
+        beta   = 1.0;
+        c      = t[k];
+        weight = w[k];
+    } else {
+        // SSP-RK(s,2): s-1 forward Euler stages of dt/(s-1), then the
+        // average with S^n; s = 2 is the classic Heun scheme
+        const int s = mol_stages;
+        alpha  = (k == s - 1) ? 1.0 / s : 0.0;
+        beta   = 1.0 / (s - 1);
+        c      = static_cast<Real>(k) / (s - 1);
+        weight = 1.0 / s;
+    }
+}
+
+int
+CAMR::retrySubcycles (const MultiFab& S_old, const MultiFab& S_new, Real dt)
+{
+  // Check an update for failure: density, total or internal energy that
+  // is not positive (or not finite), or, with hard_cfl_limit, waves crossing more
+  // than a cell in dt. Returns the number of substeps to redo the step
+  // with, or 1 if the update is good.
+
+    BL_PROFILE("CAMR::retrySubcycles()");
+
+    int bad = amrex::ReduceMax(S_new, S_old, 0,
+        [=] AMREX_GPU_HOST_DEVICE (Box const& bx, Array4<Real const> const& sn,
+                                   Array4<Real const> const& so) -> int
+        {
+            int r = 0;
+            amrex::Loop(bx, [=,&r] (int i, int j, int k) noexcept
+            {
+                // Covered cells carry no state
+                if (so(i,j,k,URHO) > 0.0 &&
+                    !(sn(i,j,k,URHO) > 0.0 && sn(i,j,k,UEDEN) > 0.0 &&
+                      sn(i,j,k,UEINT) > 0.0)) {
+                    r = 1;
+                }
+            });
+            return r;
+        });
+    ParallelDescriptor::ReduceIntMax(bad);
+
+    if (bad) {
+        // Substeps small enough that the density changes by at most
+        // retry_neg_dens_factor of itself in each
+        int nsub = 2;
+        if (retry_neg_dens_factor > 0.0) {
+            Real drop = amrex::ReduceMax(S_new, S_old, 0,
+                [=] AMREX_GPU_HOST_DEVICE (Box const& bx, Array4<Real const> const& sn,
+                                           Array4<Real const> const& so) -> Real
+                {
+                    Real r = 0.0;
+                    amrex::Loop(bx, [=,&r] (int i, int j, int k) noexcept
+                    {
+                        if (so(i,j,k,URHO) > 0.0) {
+                            r = amrex::max(r, (so(i,j,k,URHO) - sn(i,j,k,URHO)) / so(i,j,k,URHO));
+                        }
+                    });
+                    return r;
+                });
+            ParallelDescriptor::ReduceRealMax(drop);
+            if (std::isfinite(drop)) {
+                nsub = std::max(nsub, static_cast<int>(std::ceil(drop / retry_neg_dens_factor)));
+            }
+        }
+        return nsub;
+    }
+
+    if (hard_cfl_limit) {
+        const Real courant = dt / signalCrossingTime(S_new);
+        if (courant > 1.0) {
+            return std::max(2, static_cast<int>(std::ceil(courant / cfl)));
+        }
+    }
+
+    return 1;
 }
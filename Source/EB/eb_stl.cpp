@@ -0,0 +1,407 @@
+#include <AMReX_EB2.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParmParse.H>
+
+#include <eb_stl.H>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <sstream>
+
+using namespace amrex;
+
+#if (AMREX_SPACEDIM == 3)
+namespace {
+
+constexpr int leaf_size = 4;
+
+RealArray sub (const RealArray& a, const RealArray& b)
+{
+    return {a[0]-b[0], a[1]-b[1], a[2]-b[2]};
+}
+
+Real dot (const RealArray& a, const RealArray& b)
+{
+    return a[0]*b[0] + a[1]*b[1] + a[2]*b[2];
+}
+
+RealArray cross (const RealArray& a, const RealArray& b)
+{
+    return {a[1]*b[2]-a[2]*b[1], a[2]*b[0]-a[0]*b[2], a[0]*b[1]-a[1]*b[0]};
+}
+
+// Read the triangles of an ASCII or binary STL file
+Vector<STLIF::Triangle> read_stl (const std::string& file)
+{
+    std::ifstream ifs(file, std::ios::binary);
+    if (!ifs.good()) {
+        amrex::Abort("make_eb_stl: cannot open " + file);
+    }
+    std::string buf((std::istreambuf_iterator<char>(ifs)),
+                    std::istreambuf_iterator<char>());
+
+    Vector<STLIF::Triangle> tris;
+
+    // A binary file is an 80 byte header, a triangle count and 50 bytes per
+    // triangle; anything else is parsed as text
+    std::uint32_t ntri = 0;
+    if (buf.size() >= 84) {
+        std::memcpy(&ntri, buf.data() + 80, sizeof(ntri));
+    }
+    if (buf.size() >= 84 && buf.size() == 84 + 50 * std::size_t(ntri)) {
+        tris.resize(ntri);
+        const char* c = buf.data() + 84;
+        for (std::uint32_t t = 0; t < ntri; ++t, c += 50) {
+            float v[12];
+            std::memcpy(v, c, sizeof(v));
+            for (int d = 0; d < 3; ++d) {
+                tris[t].v0[d] = v[3+d];
+                tris[t].v1[d] = v[6+d];
+                tris[t].v2[d] = v[9+d];
+            }
+        }
+    } else {
+        std::istringstream is(buf);
+        std::string word;
+        Vector<RealArray> verts;
+        while (is >> word) {
+            if (word == "vertex") {
+                RealArray v;
+                is >> v[0] >> v[1] >> v[2];
+                verts.push_back(v);
+                if (verts.size() == 3) {
+                    tris.push_back({verts[0], verts[1], verts[2]});
+                    verts.clear();
+                }
+            } else if (word == "endloop") {
+                verts.clear();
+            }
+        }
+    }
+
+    if (tris.empty()) {
+        amrex::Abort("make_eb_stl: no triangles in " + file);
+    }
+    return tris;
+}
+
+// Build the hierarchy over tris[first, first+count), reordering the
+// triangles so that every node covers a contiguous range
+void build_node (Vector<STLIF::Triangle>& tris, Vector<RealArray>& cent,
+                 Vector<STLIF::Node>& nodes, int inode, int first, int count)
+{
+    STLIF::Node node;
+    node.lo = { std::numeric_limits<Real>::max(),  std::numeric_limits<Real>::max(),
+                std::numeric_limits<Real>::max()};
+    node.hi = {-std::numeric_limits<Real>::max(), -std::numeric_limits<Real>::max(),
+               -std::numeric_limits<Real>::max()};
+    RealArray clo = node.lo;
+    RealArray chi = node.hi;
+    for (int t = first; t < first + count; ++t) {
+        for (const auto& v : {tris[t].v0, tris[t].v1, tris[t].v2}) {
+            for (int d = 0; d < 3; ++d) {
+                node.lo[d] = std::min(node.lo[d], v[d]);
+                node.hi[d] = std::max(node.hi[d], v[d]);
+            }
+        }
+        for (int d = 0; d < 3; ++d) {
+            clo[d] = std::min(clo[d], cent[t][d]);
+            chi[d] = std::max(chi[d], cent[t][d]);
+        }
+    }
+
+    if (count <= leaf_size) {
+        node.first = first;
+        node.count = count;
+        nodes[inode] = node;
+        return;
+    }
+
+    // Median split along the longest extent of the centroids
+    int axis = 0;
+    for (int d = 1; d < 3; ++d) {
+        if (chi[d] - clo[d] > chi[axis] - clo[axis]) { axis = d; }
+    }
+    Vector<int> order(count);
+    std::iota(order.begin(), order.end(), first);
+    const int half = count / 2;
+    std::nth_element(order.begin(), order.begin() + half, order.end(),
+                     [&] (int a, int b) { return cent[a][axis] < cent[b][axis]; });
+    Vector<STLIF::Triangle> tsort(count);
+    Vector<RealArray> csort(count);
+    for (int n = 0; n < count; ++n) {
+        tsort[n] = tris[order[n]];
+        csort[n] = cent[order[n]];
+    }
+    std::copy(tsort.begin(), tsort.end(), tris.begin() + first);
+    std::copy(csort.begin(), csort.end(), cent.begin() + first);
+
+    node.left = static_cast<int>(nodes.size());
+    nodes[inode] = node;
+    nodes.resize(nodes.size() + 2);
+    build_node(tris, cent, nodes, node.left    , first       , half);
+    build_node(tris, cent, nodes, node.left + 1, first + half, count - half);
+}
+
+Real box_dist2 (const STLIF::Node& node, const RealArray& p)
+{
+    Real d2 = 0.0;
+    for (int d = 0; d < 3; ++d) {
+        const Real e = std::max({node.lo[d] - p[d], Real(0.0), p[d] - node.hi[d]});
+        d2 += e*e;
+    }
+    return d2;
+}
+
+// Squared distance from p to a triangle (closest point by Voronoi region)
+Real tri_dist2 (const STLIF::Triangle& t, const RealArray& p)
+{
+    const RealArray ab = sub(t.v1, t.v0);
+    const RealArray ac = sub(t.v2, t.v0);
+    const RealArray ap = sub(p, t.v0);
+    const Real d1 = dot(ab, ap);
+    const Real d2 = dot(ac, ap);
+    RealArray c;
+    if (d1 <= 0.0 && d2 <= 0.0) {
+        c = t.v0;
+    } else {
+        const RealArray bp = sub(p, t.v1);
+        const Real d3 = dot(ab, bp);
+        const Real d4 = dot(ac, bp);
+        const RealArray cp = sub(p, t.v2);
+        const Real d5 = dot(ab, cp);
+        const Real d6 = dot(ac, cp);
+        const Real vc = d1*d4 - d3*d2;
+        const Real vb = d5*d2 - d1*d6;
+        const Real va = d3*d6 - d5*d4;
+        if (d3 >= 0.0 && d4 <= d3) {
+            c = t.v1;
+        } else if (d6 >= 0.0 && d5 <= d6) {
+            c = t.v2;
+        } else if (vc <= 0.0 && d1 >= 0.0 && d3 <= 0.0) {
+            const Real v = d1 / (d1 - d3);
+            c = {t.v0[0]+v*ab[0], t.v0[1]+v*ab[1], t.v0[2]+v*ab[2]};
+        } else if (vb <= 0.0 && d2 >= 0.0 && d6 <= 0.0) {
+            const Real w = d2 / (d2 - d6);
+            c = {t.v0[0]+w*ac[0], t.v0[1]+w*ac[1], t.v0[2]+w*ac[2]};
+        } else if (va <= 0.0 && (d4 - d3) >= 0.0 && (d5 - d6) >= 0.0) {
+            const Real w = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+            c = {t.v1[0]+w*(t.v2[0]-t.v1[0]), t.v1[1]+w*(t.v2[1]-t.v1[1]),
+                 t.v1[2]+w*(t.v2[2]-t.v1[2])};
+        } else {
+            const Real denom = 1.0 / (va + vb + vc);
+            const Real v = vb * denom;
+            const Real w = vc * denom;
+            c = {t.v0[0]+ab[0]*v+ac[0]*w, t.v0[1]+ab[1]*v+ac[1]*w,
+                 t.v0[2]+ab[2]*v+ac[2]*w};
+        }
+    }
+    const RealArray pc = sub(p, c);
+    return dot(pc, pc);
+}
+
+// Direction of the parity ray; deliberately not aligned with the grid so
+// that it rarely grazes edges of axis-aligned facets
+const RealArray ray_dir = {0.5406408174555976, 0.6296101541882233, 0.5580638534017566};
+
+bool ray_hits_box (const STLIF::Node& node, const RealArray& p)
+{
+    Real tmin = 0.0;
+    Real tmax = std::numeric_limits<Real>::max();
+    for (int d = 0; d < 3; ++d) {
+        const Real inv = 1.0 / ray_dir[d];
+        Real t0 = (node.lo[d] - p[d]) * inv;
+        Real t1 = (node.hi[d] - p[d]) * inv;
+        if (t0 > t1) { std::swap(t0, t1); }
+        tmin = std::max(tmin, t0);
+        tmax = std::min(tmax, t1);
+        if (tmin > tmax) { return false; }
+    }
+    return true;
+}
+
+// Moller-Trumbore intersection of the parity ray with a triangle
+bool ray_hits_tri (const STLIF::Triangle& t, const RealArray& p)
+{
+    const RealArray e1 = sub(t.v1, t.v0);
+    const RealArray e2 = sub(t.v2, t.v0);
+    const RealArray h = cross(ray_dir, e2);
+    const Real a = dot(e1, h);
+    if (std::abs(a) < std::numeric_limits<Real>::min()) { return false; }
+    const Real f = 1.0 / a;
+    const RealArray s = sub(p, t.v0);
+    const Real u = f * dot(s, h);
+    if (u < 0.0 || u > 1.0) { return false; }
+    const RealArray q = cross(s, e1);
+    const Real v = f * dot(ray_dir, q);
+    if (v < 0.0 || u + v > 1.0) { return false; }
+    return f * dot(e2, q) > 0.0;
+}
+
+} // namespace
+
+STLIF::STLIF (const std::string& a_file, Real a_scale,
+              const RealArray& a_center, bool a_inside)
+    : m_inside(a_inside)
+{
+    auto data = std::make_shared<Data>();
+
+    // Read on one rank and broadcast the vertices
+    Vector<Real> flat;
+    if (ParallelDescriptor::IOProcessor()) {
+        const auto tris = read_stl(a_file);
+        flat.reserve(9 * tris.size());
+        for (const auto& t : tris) {
+            for (const auto& v : {t.v0, t.v1, t.v2}) {
+                for (int d = 0; d < 3; ++d) {
+                    flat.push_back(a_scale * v[d] + a_center[d]);
+                }
+            }
+        }
+    }
+    Long nflat = flat.size();
+    ParallelDescriptor::Bcast(&nflat, 1, ParallelDescriptor::IOProcessorNumber());
+    flat.resize(nflat);
+    ParallelDescriptor::Bcast(flat.data(), nflat, ParallelDescriptor::IOProcessorNumber());
+
+    const int ntri = static_cast<int>(nflat / 9);
+    data->tris.resize(ntri);
+    Vector<RealArray> cent(ntri);
+    for (int t = 0; t < ntri; ++t) {
+        const Real* v = flat.data() + 9*t;
+        data->tris[t].v0 = {v[0], v[1], v[2]};
+        data->tris[t].v1 = {v[3], v[4], v[5]};
+        data->tris[t].v2 = {v[6], v[7], v[8]};
+        for (int d = 0; d < 3; ++d) {
+            cent[t][d] = (v[d] + v[3+d] + v[6+d]) / 3.0;
+        }
+    }
+
+    data->nodes.resize(1);
+    data->nodes.reserve(2 * (ntri / leaf_size + 1));
+    build_node(data->tris, cent, data->nodes, 0, 0, ntri);
+
+    m_data = data;
+}
+
+int
+STLIF::numTriangles () const
+{
+    return static_cast<int>(m_data->tris.size());
+}
+
+Real
+STLIF::distance (const RealArray& p) const
+{
+    const auto& nodes = m_data->nodes;
+    const auto& tris  = m_data->tris;
+
+    Real best = std::numeric_limits<Real>::max();
+    int stack[64];
+    int top = 0;
+    stack[top++] = 0;
+    while (top > 0) {
+        const Node& node = nodes[stack[--top]];
+        if (box_dist2(node, p) >= best) { continue; }
+        if (node.count > 0) {
+            for (int t = node.first; t < node.first + node.count; ++t) {
+                best = std::min(best, tri_dist2(tris[t], p));
+            }
+        } else {
+            // Visit the nearer child first so the far one is more often pruned
+            int l = node.left;
+            int r = node.left + 1;
+            if (box_dist2(nodes[l], p) < box_dist2(nodes[r], p)) { std::swap(l, r); }
+            stack[top++] = l;
+            stack[top++] = r;
+        }
+    }
+    return std::sqrt(best);
+}
+
+bool
+STLIF::contains (const RealArray& p) const
+{
+    const auto& nodes = m_data->nodes;
+    const auto& tris  = m_data->tris;
+
+    int crossings = 0;
+    int stack[64];
+    int top = 0;
+    stack[top++] = 0;
+    while (top > 0) {
+        const Node& node = nodes[stack[--top]];
+        if (!ray_hits_box(node, p)) { continue; }
+        if (node.count > 0) {
+            for (int t = node.first; t < node.first + node.count; ++t) {
+                if (ray_hits_tri(tris[t], p)) { ++crossings; }
+            }
+        } else {
+            stack[top++] = node.left;
+            stack[top++] = node.left + 1;
+        }
+    }
+    return (crossings % 2) == 1;
+}
+
+Real
+STLIF::operator() (const RealArray& p) const
+{
+    // Negative in the fluid, as for the amrex implicit functions
+    const Real d = distance(p);
+    const bool in_solid = contains(p);
+    const Real f = in_solid ? d : -d;
+    return m_inside ? -f : f;
+}
+#endif
+
+/********************************************************************************
+ *                                                                              *
+ * Function to create an EB from a triangulated surface.                        *
+ *                                                                              *
+ ********************************************************************************/
+void make_eb_stl (const Geometry& geom, int required_coarsening_level)
+{
+#if (AMREX_SPACEDIM == 3)
+    // Initialise STL parameters
+    std::string file;
+    bool inside = false;
+    Real scale = 1.0;
+    Vector<Real> centervec(3, 0.0);
+
+    // Get surface information from inputs file.
+    ParmParse pp("stl");
+
+    pp.get("file", file);
+    pp.query("internal_flow", inside);
+    pp.query("scale", scale);
+    pp.queryarr("center", centervec, 0, 3);
+    RealArray center = {centervec[0], centervec[1], centervec[2]};
+
+    STLIF my_stl(file, scale, center, inside);
+
+    // Print info about surface
+    amrex::Print() << " " << std::endl;
+    amrex::Print() << " File:          " << file << std::endl;
+    amrex::Print() << " Triangles:     " << my_stl.numTriangles() << std::endl;
+    amrex::Print() << " Internal Flow: " << inside << std::endl;
+    amrex::Print() << " Scale:         " << scale << std::endl;
+    amrex::Print() << " Center:        " << center[0] << ", " << center[1] << ", " << center[2]
+                   << std::endl;
+
+    // Generate GeometryShop
+    auto gshop = EB2::makeShop(my_stl);
+
+    // Build index space
+    EB2::Build(gshop, geom, required_coarsening_level, required_coarsening_level);
+#else
+    amrex::ignore_unused(geom, required_coarsening_level);
+    amrex::Abort("STL geometry requires AMREX_SPACEDIM == 3");
+#endif
+}
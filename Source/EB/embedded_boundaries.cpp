@@ -1,6 +1,14 @@
+#include <AMReX_ParallelDescriptor.H>
 #include <AMReX_ParmParse.H>
+#include <AMReX_Utility.H>
 
 #include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <vector>
 #include <CAMR.H>
 
 using namespace amrex;
@@ -9,6 +17,90 @@ void make_eb_regular(const Geometry& geom);
 void make_eb_sphere(const Geometry& geom, int required_coarsening_level);
 void make_eb_box(const Geometry& geom, int required_coarsening_level);
 void make_eb_cylinder(const Geometry& geom, int required_coarsening_level);
+void make_eb_stl(const Geometry& geom, int required_coarsening_level);
+
+namespace {
+
+// 64-bit FNV-1a of n bytes, continuing from hash
+std::uint64_t
+fnv1a (std::uint64_t hash, const char* data, std::size_t n)
+{
+    for (std::size_t i = 0; i < n; ++i) {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+// Name of the cached index space for this geometry. The key hashes every
+// input the make_eb_* functions and EB2::Build read together with the
+// domain, so a change to any of them selects a different cache entry.
+std::string
+eb_cache_name (const std::string& geom_type, const Geometry& geom,
+               const int required_coarsening_level)
+{
+    static const std::map<std::string, std::vector<std::string>> geom_keys = {
+        {"sphere",   {"internal_flow", "radius", "center"}},
+        {"box",      {"Lo", "Hi", "offset"}},
+        {"cylinder", {"internal_flow", "radius", "direction", "rotation",
+                      "rotation_axe", "center"}},
+        {"stl",      {"file", "internal_flow", "scale", "center"}}};
+
+    std::ostringstream key;
+    key << std::setprecision(17) << geom_type << ' ' << AMREX_SPACEDIM << ' '
+        << geom.Domain() << ' ' << required_coarsening_level;
+    for (int dir = 0; dir < AMREX_SPACEDIM; ++dir) {
+        key << ' ' << geom.ProbLo(dir) << ' ' << geom.ProbHi(dir)
+            << ' ' << geom.isPeriodic(dir);
+    }
+
+    ParmParse pp(geom_type);
+    for (const auto& name : geom_keys.at(geom_type)) {
+        Vector<std::string> vals;
+        pp.queryarr(name.c_str(), vals);
+        key << ' ' << name << '=';
+        for (const auto& v : vals) {
+            key << v << ',';
+        }
+    }
+
+    // Options EB2::Build reads itself
+    ParmParse ppeb2("eb2");
+    for (const char* name : {"max_grid_size", "extend_domain_face", "num_coarsen_opt"}) {
+        Vector<std::string> vals;
+        ppeb2.queryarr(name, vals);
+        key << " eb2." << name << '=';
+        for (const auto& v : vals) {
+            key << v << ',';
+        }
+    }
+
+    const std::string key_str = key.str();
+    std::uint64_t hash = fnv1a(14695981039346656037ULL, key_str.data(), key_str.size());
+
+    // The surface itself may change under the same file name. The IO
+    // processor streams it through the hash and passes the result on.
+    if (geom_type == "stl") {
+        if (ParallelDescriptor::IOProcessor()) {
+            std::string file;
+            pp.get("file", file);
+            std::ifstream ifs(file, std::ios::binary);
+            std::vector<char> buf(1 << 20);
+            while (ifs.read(buf.data(), static_cast<std::streamsize>(buf.size())) ||
+                   ifs.gcount() > 0) {
+                hash = fnv1a(hash, buf.data(), static_cast<std::size_t>(ifs.gcount()));
+            }
+        }
+        ParallelDescriptor::Bcast(&hash, 1, ParallelDescriptor::IOProcessorNumber());
+    }
+
+    std::ostringstream name;
+    name << "eb2_" << geom_type << '_' << std::hex << std::setw(16)
+         << std::setfill('0') << hash;
+    return name.str();
+}
+
+} // namespace
 
 void
 initialize_EB2 (const Geometry& geom, const int required_coarsening_level,
@@ -16,7 +108,7 @@ initialize_EB2 (const Geometry& geom, const int required_coarsening_level,
 {
    /******************************************************************************
    * CAMR.geometry=<string> specifies the EB geometry. <string> can be one of    *
-   * box, cylinder, sphere, spherecube, twocylinders
+   * box, cylinder, sphere, stl
    ******************************************************************************/
 
     ParmParse pp("CAMR");
@@ -24,6 +116,31 @@ initialize_EB2 (const Geometry& geom, const int required_coarsening_level,
     std::string geom_type;
     pp.query("geometry", geom_type);
 
+    // CAMR.eb_cache_dir=<path> keeps the generated index space on disk so
+    // that later runs and restarts with the same geometry read it back
+    // instead of evaluating the implicit function again
+    std::string cache_dir;
+    pp.query("eb_cache_dir", cache_dir);
+
+    const bool use_cache = !cache_dir.empty() &&
+        (geom_type == "cylinder" || geom_type == "box" || geom_type == "sphere" ||
+         geom_type == "stl");
+
+    std::string cache_file;
+    if (use_cache) {
+        cache_file = cache_dir + "/" +
+            eb_cache_name(geom_type, geom, required_coarsening_level);
+
+        if (amrex::FileExists(cache_file)) {
+            amrex::Print() << "\n Reading " << geom_type << " geometry from "
+                           << cache_file << std::endl;
+            EB2::BuildFromChkptFile(cache_file, geom, required_coarsening_level,
+                                    required_coarsening_level);
+            amrex::Print() << "Done making the geometry ebfactory.\n" << std::endl;
+            return;
+        }
+    }
+
    /******************************************************************************
    *                                                                            *
    *  CONSTRUCT EB                                                              *
@@ -45,11 +162,30 @@ initialize_EB2 (const Geometry& geom, const int required_coarsening_level,
     amrex::Print() << "\n Building sphere geometry." << std::endl;
         make_eb_sphere(geom, required_coarsening_level);
     }
+    else if(geom_type == "stl")
+    {
+        amrex::Print() << "\n Building STL geometry." << std::endl;
+        make_eb_stl(geom, required_coarsening_level);
+    }
     else
     {
     amrex::Print() << "\n No EB geometry declared in inputs => "
                    << " Will build all regular geometry." << std::endl;
         make_eb_regular(geom);
     }
+
+    if (use_cache) {
+        if (ParallelDescriptor::IOProcessor()) {
+            if (!amrex::UtilCreateDirectory(cache_dir, 0755)) {
+                amrex::CreateDirectoryFailed(cache_dir);
+            }
+        }
+        ParallelDescriptor::Barrier();
+
+        amrex::Print() << " Writing geometry cache " << cache_file << std::endl;
+        const int max_grid_size = 64;
+        EB2::IndexSpace::top().getLevel(geom).write_to_chkpt_file(
+            cache_file, EB2::ExtendDomainFace(), max_grid_size);
+    }
     amrex::Print() << "Done making the geometry ebfactory.\n" << std::endl;
 }
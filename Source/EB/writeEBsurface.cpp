@@ -1,18 +1,232 @@
 #include <CAMR.H>
-#include <AMReX_WriteEBSurface.H>
+
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_Utility.H>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
 
 #if (AMREX_SPACEDIM == 3)
+namespace {
+
+// Polygon where the EB plane of a cut cell crosses the cell, in index units
+// relative to the cell center. Returns the number of vertices (0 or 3-6).
+int
+cut_cell_polygon (const amrex::RealArray& b, const amrex::RealArray& n,
+                  amrex::Real poly[6][3])
+{
+    static const int corner[8][3] = {{0,0,0},{1,0,0},{1,1,0},{0,1,0},
+                                     {0,0,1},{1,0,1},{1,1,1},{0,1,1}};
+    static const int edge[12][2] = {{0,1},{1,2},{2,3},{3,0},{4,5},{5,6},
+                                    {6,7},{7,4},{0,4},{1,5},{2,6},{3,7}};
+
+    amrex::Real f[8];
+    for (int c = 0; c < 8; ++c) {
+        f[c] = 0.0;
+        for (int d = 0; d < 3; ++d) {
+            f[c] += n[d] * (corner[c][d] - 0.5 - b[d]);
+        }
+    }
+
+    int np = 0;
+    for (const auto& e : edge) {
+        const amrex::Real fa = f[e[0]];
+        const amrex::Real fb = f[e[1]];
+        if ((fa < 0.0) != (fb < 0.0)) {
+            const amrex::Real t = fa / (fa - fb);
+            for (int d = 0; d < 3; ++d) {
+                poly[np][d] = corner[e[0]][d] - 0.5
+                    + t * (corner[e[1]][d] - corner[e[0]][d]);
+            }
+            ++np;
+        }
+    }
+    if (np < 3) {
+        return 0;
+    }
+
+    // Order the vertices by angle around their centroid in the plane
+    amrex::Real c[3] = {0.0, 0.0, 0.0};
+    for (int p = 0; p < np; ++p) {
+        for (int d = 0; d < 3; ++d) { c[d] += poly[p][d] / np; }
+    }
+    const int imin = (std::abs(n[0]) < std::abs(n[1]))
+        ? ((std::abs(n[0]) < std::abs(n[2])) ? 0 : 2)
+        : ((std::abs(n[1]) < std::abs(n[2])) ? 1 : 2);
+    amrex::Real a[3] = {0.0, 0.0, 0.0};
+    a[imin] = 1.0;
+    const amrex::Real u[3] = {n[1]*a[2]-n[2]*a[1], n[2]*a[0]-n[0]*a[2], n[0]*a[1]-n[1]*a[0]};
+    const amrex::Real v[3] = {n[1]*u[2]-n[2]*u[1], n[2]*u[0]-n[0]*u[2], n[0]*u[1]-n[1]*u[0]};
+    amrex::Real ang[6];
+    for (int p = 0; p < np; ++p) {
+        amrex::Real x = 0.0;
+        amrex::Real y = 0.0;
+        for (int d = 0; d < 3; ++d) {
+            x += (poly[p][d] - c[d]) * u[d];
+            y += (poly[p][d] - c[d]) * v[d];
+        }
+        ang[p] = std::atan2(y, x);
+    }
+    for (int p = 1; p < np; ++p) {
+        for (int q = p; q > 0 && ang[q] < ang[q-1]; --q) {
+            std::swap(ang[q], ang[q-1]);
+            for (int d = 0; d < 3; ++d) { std::swap(poly[q][d], poly[q-1][d]); }
+        }
+    }
+    return np;
+}
+
+} // namespace
+
+// Write the EB surface of this level as VTK XML polydata with raw appended
+// binary data. Every rank extracts the polygons of its own cut cells, and
+// the I/O rank gathers them in rank order and writes the file.
 void CAMR::WriteMyEBSurface ()
 {
   using namespace amrex;
 
-  amrex::Print() << "Writing the geometry to a vtp file.\n" << std::endl;
+  BL_PROFILE("CAMR::WriteMyEBSurface()");
+
+  // The geometry is fixed during a run, so the surface of a level only
+  // changes when its grids do
+  if (level >= static_cast<int>(eb_surface_grids.size())) {
+    eb_surface_grids.resize(level + 1);
+  }
+  if (eb_surface_grids[level] == grids) {
+    return;
+  }
+  eb_surface_grids[level] = grids;
+
+  const std::string fname = amrex::Concatenate("eb_surface_lev", level, 1) + ".vtp";
+  amrex::Print() << "Writing the geometry to " << fname << "\n" << std::endl;
+
+  const auto& flags = EBFactory().getMultiEBCellFlagFab();
+  const auto& bnorm = EBFactory().getBndryNormal();
+  const auto& problo = geom.ProbLoArray();
+  const auto& dx = geom.CellSizeArray();
+
+  Vector<float> pts;
+  Vector<std::int64_t> offs;
+  for (MFIter mfi(flags); mfi.isValid(); ++mfi) {
+    const Box& bx = mfi.validbox();
+    if (flags[mfi].getType(bx) != FabType::singlevalued) {
+      continue;
+    }
+#ifdef AMREX_USE_GPU
+    // The polygons are built on the host from a copy of the EB data
+    BaseFab<EBCellFlag> flag_h(bx, 1, The_Pinned_Arena());
+    FArrayBox bc_h(bx, AMREX_SPACEDIM, The_Pinned_Arena());
+    FArrayBox bn_h(bx, AMREX_SPACEDIM, The_Pinned_Arena());
+    flag_h.copy<RunOn::Device>(flags[mfi], bx);
+    bc_h.copy<RunOn::Device>((*bndrycent)[mfi], bx);
+    bn_h.copy<RunOn::Device>(bnorm[mfi], bx);
+    Gpu::streamSynchronize();
+    const auto& flag = flag_h.const_array();
+    const auto& bc = bc_h.const_array();
+    const auto& bn = bn_h.const_array();
+#else
+    const auto& flag = flags.const_array(mfi);
+    const auto& bc = bndrycent->const_array(mfi);
+    const auto& bn = bnorm.const_array(mfi);
+#endif
+    amrex::LoopOnCpu(bx, [&] (int i, int j, int k) noexcept
+    {
+      if (!flag(i,j,k).isSingleValued()) {
+        return;
+      }
+      const RealArray b = {bc(i,j,k,0), bc(i,j,k,1), bc(i,j,k,2)};
+      const RealArray n = {bn(i,j,k,0), bn(i,j,k,1), bn(i,j,k,2)};
+      Real poly[6][3];
+      const int np = cut_cell_polygon(b, n, poly);
+      if (np == 0) {
+        return;
+      }
+      const int iv[3] = {i, j, k};
+      for (int p = 0; p < np; ++p) {
+        for (int d = 0; d < 3; ++d) {
+          pts.push_back(static_cast<float>(problo[d] + (iv[d] + 0.5 + poly[p][d]) * dx[d]));
+        }
+      }
+      offs.push_back(static_cast<std::int64_t>(pts.size() / 3));
+    });
+  }
+
+  // Gather the points and the rank-local polygon offsets on the I/O rank
+  const int nprocs = ParallelDescriptor::NProcs();
+  const int ioproc = ParallelDescriptor::IOProcessorNumber();
+  int mine[2] = {static_cast<int>(pts.size()), static_cast<int>(offs.size())};
+  Vector<int> counts(2 * nprocs);
+  ParallelDescriptor::Gather(mine, 2, counts.data(), ioproc);
+
+  Vector<int> pts_counts(nprocs), pts_disp(nprocs), offs_counts(nprocs), offs_disp(nprocs);
+  Long npts3 = 0;
+  Long npoly = 0;
+  for (int r = 0; r < nprocs; ++r) {
+    pts_counts[r]  = counts[2*r];
+    offs_counts[r] = counts[2*r+1];
+    pts_disp[r]    = static_cast<int>(npts3);
+    offs_disp[r]   = static_cast<int>(npoly);
+    npts3 += pts_counts[r];
+    npoly += offs_counts[r];
+  }
+
+  const bool ioproc_here = ParallelDescriptor::IOProcessor();
+  Vector<float> all_pts(ioproc_here ? npts3 : 0);
+  Vector<std::int64_t> all_offs(ioproc_here ? npoly : 0);
+  ParallelDescriptor::Gatherv(pts.data(), mine[0], all_pts.data(), pts_counts, pts_disp, ioproc);
+  ParallelDescriptor::Gatherv(offs.data(), mine[1], all_offs.data(), offs_counts, offs_disp, ioproc);
+
+  if (!ioproc_here) {
+    return;
+  }
 
-  BoxArray & ba            = grids;
-  DistributionMapping & dm = dmap;
+  // Each polygon has its own vertices, so the connectivity is the identity
+  // and the offsets are running vertex counts
+  const Long npts = npts3 / 3;
+  for (int r = 0; r < nprocs; ++r) {
+    for (int p = offs_disp[r]; p < offs_disp[r] + offs_counts[r]; ++p) {
+      all_offs[p] += pts_disp[r] / 3;
+    }
+  }
+  Vector<std::int64_t> conn(npts);
+  for (Long p = 0; p < npts; ++p) {
+    conn[p] = p;
+  }
 
-  const EBFArrayBoxFactory* ebfact = &EBFactory();
+  const std::uint64_t pts_bytes  = 3 * sizeof(float) * npts;
+  const std::uint64_t conn_bytes = sizeof(std::int64_t) * npts;
+  const std::uint64_t offs_bytes = sizeof(std::int64_t) * npoly;
+  const std::uint64_t conn_start = sizeof(std::uint64_t) + pts_bytes;
+  const std::uint64_t offs_start = conn_start + sizeof(std::uint64_t) + conn_bytes;
 
-  WriteEBSurface(ba,dm,geom,ebfact);
+  std::ofstream ofs(fname, std::ios::binary | std::ios::trunc);
+  if (!ofs.good()) {
+    amrex::FileOpenFailed(fname);
+  }
+  ofs << "<?xml version=\"1.0\"?>\n"
+      << "<VTKFile type=\"PolyData\" version=\"1.0\" byte_order=\"LittleEndian\" header_type=\"UInt64\">\n"
+      << "  <PolyData>\n"
+      << "    <Piece NumberOfPoints=\"" << npts << "\" NumberOfVerts=\"0\" NumberOfLines=\"0\""
+      << " NumberOfStrips=\"0\" NumberOfPolys=\"" << npoly << "\">\n"
+      << "      <Points>\n"
+      << "        <DataArray type=\"Float32\" NumberOfComponents=\"3\" format=\"appended\" offset=\"0\"/>\n"
+      << "      </Points>\n"
+      << "      <Polys>\n"
+      << "        <DataArray type=\"Int64\" Name=\"connectivity\" format=\"appended\" offset=\"" << conn_start << "\"/>\n"
+      << "        <DataArray type=\"Int64\" Name=\"offsets\" format=\"appended\" offset=\"" << offs_start << "\"/>\n"
+      << "      </Polys>\n"
+      << "    </Piece>\n"
+      << "  </PolyData>\n"
+      << "  <AppendedData encoding=\"raw\">\n"
+      << "   _";
+  ofs.write(reinterpret_cast<const char*>(&pts_bytes), sizeof(pts_bytes));
+  ofs.write(reinterpret_cast<const char*>(all_pts.data()), static_cast<std::streamsize>(pts_bytes));
+  ofs.write(reinterpret_cast<const char*>(&conn_bytes), sizeof(conn_bytes));
+  ofs.write(reinterpret_cast<const char*>(conn.data()), static_cast<std::streamsize>(conn_bytes));
+  ofs.write(reinterpret_cast<const char*>(&offs_bytes), sizeof(offs_bytes));
+  ofs.write(reinterpret_cast<const char*>(all_offs.data()), static_cast<std::streamsize>(offs_bytes));
+  ofs << "\n  </AppendedData>\n</VTKFile>\n";
 }
 #endif
@@ -13,7 +13,7 @@ adjust_fluxes (
     const Box& bx,
     Array4<const Real> const& u,
     const amrex::GpuArray<const Array4<     Real>, AMREX_SPACEDIM> flx,
-    const amrex::GpuArray<const Array4<const Real>, AMREX_SPACEDIM> a,
+    const amrex::GpuArray<Real, AMREX_SPACEDIM> a,
     Array4<const Real> const& divu,
     const amrex::GpuArray<Real, AMREX_SPACEDIM> del,
     const int* domlo, const int* domhi,
@@ -24,6 +24,7 @@ adjust_fluxes (
   for (int dir = 0; dir < AMREX_SPACEDIM; dir++) {
     Box const& fbx = surroundingNodes(bx, dir);
     const Real dx = del[dir];
+    const Real area = a[dir];
     int domlo_dir = domlo[dir];
     int domhi_dir = domhi[dir];
     int  bclo_dir =  bclo[dir];
@@ -37,7 +38,7 @@ adjust_fluxes (
       CAMR_norm_spec_flx(i, j, k, flx[dir]);
 
       // Make flux extensive
-      CAMR_ext_flx(i, j, k, flx[dir], a[dir]);
+      CAMR_ext_flx(i, j, k, flx[dir], area);
     });
   } // dir
 }
@@ -1,17 +1,20 @@
 #include "CAMR.H"
 #include "CAMR_hydro.H"
 #include "CAMR_ctoprim.H"
+#include "Timestep.H"
 
 using namespace amrex;
 
 void
 CAMR::construct_hydro_source (const MultiFab& S,
-                              MultiFab& src_to_fill,
+                              MultiFab& S_new,
                               Real /*time*/,
-                              Real dt)
+                              Real dt,
+                              Real alpha,
+                              Real beta,
+                              int first_update,
+                              Real fac_for_reflux)
 {
-    src_to_fill.setVal(0);
-
     if (verbose) {
         if (do_mol) {
             amrex::Print() << "... Computing MOL-based hydro advance" << std::endl;
@@ -20,61 +23,183 @@ CAMR::construct_hydro_source (const MultiFab& S,
         }
     }
 
-    Real fac_for_reflux = (do_mol) ? Real(0.5) : Real(1.0);
-
     AMREX_ASSERT(S.nGrow() == numGrow());
 
-    // Fill the source terms to go into the hydro with only the old-time sources
-    int ng = 0;
+    // Fill the source terms to go into the hydro with only the old-time
+    // sources; only the Godunov predictor uses them
+    if (!do_mol) {
+        int ng = 0;
 
-    for (int n = 0; n < src_list.size(); ++n) {
-        MultiFab::Saxpy(sources_for_hydro, 1.0, *old_sources[src_list[n]], 0, 0, NVAR, ng);
+        for (int n = 0; n < src_list.size(); ++n) {
+            const auto& comps = src_comps[src_list[n]];
+            for (int m = 0; m < comps.size(); ++m) {
+                MultiFab::Saxpy(sources_for_hydro, 1.0, *old_sources[src_list[n]], m, comps[m], 1, ng);
+            }
+        }
+        for (int n = 0; n < src_list.size(); ++n) {
+            for (int comp : src_comps[src_list[n]]) {
+                sources_for_hydro.FillBoundary(comp, 1, geom.periodicity());
+            }
+        }
     }
-    sources_for_hydro.FillBoundary(geom.periodicity());
 
     int finest_level = parent->finestLevel();
 
     const auto& dx    = geom.CellSizeArray();
 
-    Real dx1 = dx[0];
-    for (int dir = 1; dir < AMREX_SPACEDIM; ++dir) {
-      dx1 *= dx[dir];
-    }
+    // Cartesian metrics: constant face areas and cell volume on this level
+    const GpuArray<Real, AMREX_SPACEDIM> area = Area();
+    const Real vol = Volume();
 
     std::array<Real, AMREX_SPACEDIM> dxD = {
-      {AMREX_D_DECL(dx1, dx1, dx1)}};
+      {AMREX_D_DECL(vol, vol, vol)}};
     const Real* dxDp = &(dxD[0]);
 
-    MultiFab& S_new = get_new_data(State_Type);
+    const MultiFab& S_old = get_old_data(State_Type);
+    const int nsrc = static_cast<int>(src_list.size());
+    GpuArray<GpuArray<int, NVAR>, num_src> slots;
+    for (int n = 0; n < nsrc; ++n) {
+        slots[n] = src_slots(src_list[n]);
+    }
+
+    AMREX_D_TERM(const Real dx1 = dx[0];, const Real dx2 = dx[1];, const Real dx3 = dx[2];)
+
+    // Norms of the density residual d(rho)/dt, taken from the first update
+    // of the step while the hydro update is at hand. Cells are weighted by
+    // their volume fraction, and cells under the next finer level by zero.
+    const bool track_residual = first_update && (steady_tol > 0.0 || verbose);
+    ReduceOps<ReduceOpSum, ReduceOpSum, ReduceOpMax, ReduceOpSum> res_op;
+    ReduceData<Real, Real, Real, Real> res_data(res_op);
+    using ResTuple = typename decltype(res_data)::Type;
+    const MultiFab* res_mask = nullptr;
+    if (track_residual && level < finest_level) {
+        res_mask = &getLevel(level + 1).build_fine_mask();
+    }
 
     BL_PROFILE_VAR("CAMR::advance_hydro_umdrv()", PC_UMDRV);
 
-#ifdef AMREX_USE_EB
-    const auto& ebfact = dynamic_cast<amrex::EBFArrayBoxFactory const&>(Factory());
-#endif
+    // Cells in the interior of the region covered by level+1 are replaced
+    // by avgDown after the step, so only the boxes listed for each tile are
+    // advanced there
+    const bool skip_covered = skip_covered_hydro && level < finest_level;
+    if (skip_covered && !(hydro_fine_grids == parent->boxArray(level + 1))) {
+        buildHydroWorkBoxes();
+    }
+
+    // The fluxes of a tile whose whole stencil holds one uniform state
+    // cancel exactly, so its hydro update is zero. The Godunov predictor
+    // adds the sources, which need not be uniform, so it is only skipped
+    // without them.
+    const bool check_quiescent = skip_quiescent_tiles && (do_mol || src_list.empty());
+    if (check_quiescent) {
+        findQuiescentTiles(S, alpha, first_update);
+    }
+
+    // Order of the split Godunov sweeps, alternated from step to step so
+    // that the splitting error cancels to second order; -1 for the unsplit
+    // method
+    const int sweep_order = (godunov_split && !do_mol) ? parent->levelSteps(level) % 2 : -1;
+
+    // Coarse levels can be kept on PLM
+    const int lev_ppm_type = (level < ppm_min_level) ? 0 : ppm_type;
+
+    // Tiles are handed out to threads dynamically since their cost varies
+    // widely: covered tiles are free and tiles with cut cells cost several
+    // times more than regular ones
+    const amrex::MFItInfo tiling = hydroTiling().SetDynamic(true);
+
+    if (local_time_stepping && first_update) {
+        lts_tile_dt.assign(MFIter(S_new, tiling).length(), dt);
+    }
 
 #ifdef _OPENMP
 #pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
 #endif
     {
 #ifdef AMREX_USE_EB
-      int ncomp = src_to_fill.nComp();
+      const int ncomp = NVAR;
       FArrayBox dm_as_fine(Box::TheUnitBox(),ncomp);
       FArrayBox fab_drho_as_crse(Box::TheUnitBox(),ncomp);
       IArrayBox fab_rrflag_as_crse(Box::TheUnitBox());
 #endif
 
-      amrex::MFItInfo tiling = amrex::TilingIfNotGPU() ? amrex::MFItInfo().EnableTiling(hydro_tile_size) : amrex::MFItInfo();
+#ifdef AMREX_USE_EB
+      // The tiles that need the EB kernels go in a first pass so that the
+      // cheap tiles fill in behind them instead of leaving one thread with
+      // an expensive tile at the end
+      for (int pass = 0; pass < 2; ++pass)
+#endif
       for (MFIter mfi(S_new, tiling); mfi.isValid(); ++mfi)
       {
         const Box& bx = mfi.tilebox();
 
+        const Vector<Box>* work_boxes = nullptr;
+        bool do_hydro = true;
+        if (skip_covered) {
+            work_boxes = &hydro_work_boxes[mfi.LocalTileIndex()];
+            do_hydro = !work_boxes->empty();
+        }
+
 #ifdef AMREX_USE_EB
-        EBCellFlagFab const& flagfab = ebfact.getMultiEBCellFlagFab()[mfi];
-        Array4<EBCellFlag const> const& flag = flagfab.const_array();
+        const EBTileInfo& eb_info = eb_tile_info[mfi.LocalTileIndex()];
+        if (eb_info.cut_boxes.empty() == (pass == 0)) {
+            continue;
+        }
+
+        Array4<EBCellFlag const> const& flag = eb_info.flag;
 
-        if (flagfab.getType(bx) != FabType::covered) {
-            auto const& vfrac_arr = volfrac->const_array(mfi);
+#endif
+
+        if (check_quiescent && tile_skipped[mfi.LocalTileIndex()]) {
+            do_hydro = false;
+        }
+
+        // Hydro update of the tile, zero wherever the hydro is skipped. The
+        // EB redistribution reaches beyond the tile.
+#ifdef AMREX_USE_EB
+        const Box& dsdt_box = eb_info.cut_boxes.empty() ? bx : amrex::grow(bx, numGrow());
+#else
+        const Box& dsdt_box = bx;
+#endif
+        FArrayBox dsdt(dsdt_box, NVAR, amrex::The_Async_Arena());
+        dsdt.setVal<RunOn::Device>(0.);
+
+        // With local time stepping the tile advances at the pseudo-timestep
+        // that the cells of its whole stencil allow, taken from the state at
+        // the start of the step on its first update and kept for the later
+        // stages and for add_new_sources. read_params rules out refluxing
+        // and the Godunov methods, whose face fluxes depend on the dt of
+        // the tile computing them, in this mode.
+        Real dt_tile = dt;
+        if (local_time_stepping && !first_update) {
+            dt_tile = lts_tile_dt[mfi.LocalTileIndex()];
+        } else if (local_time_stepping) {
+            auto const& s_arr = S.const_array(mfi);
+            ReduceOps<ReduceOpMin> reduce_op;
+            ReduceData<Real> reduce_data(reduce_op);
+            using ReduceTuple = typename decltype(reduce_data)::Type;
+            reduce_op.eval(amrex::grow(bx, numGrow()), reduce_data,
+              [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept -> ReduceTuple {
+                const IntVect iv(AMREX_D_DECL(i, j, k));
+                return {CAMR_estdt_hydro(Box(iv, iv), s_arr,
+#ifdef AMREX_USE_EB
+                                         flag,
+#endif
+                                         AMREX_D_DECL(dx1, dx2, dx3))};
+            });
+            // Fully covered tiles keep the level dt
+            const Real dt_cross = amrex::get<0>(reduce_data.value(reduce_op));
+            if (dt_cross < std::numeric_limits<Real>::max()) {
+                dt_tile = amrex::max(dt, cfl * dt_cross);
+            }
+            lts_tile_dt[mfi.LocalTileIndex()] = dt_tile;
+        }
+
+#ifdef AMREX_USE_EB
+        if (do_hydro && eb_info.type != FabType::covered) {
+            auto const& vfrac_arr = eb_info.vfrac;
+#else
+        if (do_hydro) {
 #endif
             const Box& qbx = amrex::grow(bx, numGrow());
 
@@ -86,7 +211,7 @@ CAMR::construct_hydro_source (const MultiFab& S,
             }
 
             auto const& sarr    = S.const_array(mfi);
-            auto const& hyd_src = src_to_fill.array(mfi);
+            auto const& hyd_src = dsdt.array();
 
             // Resize Temporary Fabs
             FArrayBox q(qbx, QVAR, amrex::The_Async_Arena());
@@ -118,8 +243,6 @@ CAMR::construct_hydro_source (const MultiFab& S,
 
             const GpuArray<const Array4<      Real>, AMREX_SPACEDIM>
               flx_arr{{AMREX_D_DECL(flux[0].array(), flux[1].array(), flux[2].array())}};
-            const amrex::GpuArray<const Array4<const Real>, AMREX_SPACEDIM>
-              a{{AMREX_D_DECL(area[0].array(mfi), area[1].array(mfi), area[2].array(mfi))}};
 
         // Create source terms for primitive variables
         if (!do_mol) {
@@ -131,14 +254,8 @@ CAMR::construct_hydro_source (const MultiFab& S,
         }
 
 #ifdef AMREX_USE_EB
-        int ngrow_bx;
-        if (redistribution_type == "StateRedist") {
-           ngrow_bx = 3;
-        } else {
-           ngrow_bx = 2;
-        }
-        const Box& bxg_i  = grow(bx,ngrow_bx);
-        if (flagfab.getType(bxg_i) != FabType::regular) {
+        const int ngrow_bx = eb_redist_ngrow();
+        if (eb_info.type != FabType::regular) {
 
             EBFluxRegister* fr_as_crse = nullptr;
             if (do_reflux && level < parent->finestLevel()) {
@@ -166,34 +283,81 @@ CAMR::construct_hydro_source (const MultiFab& S,
                 dm_as_fine.setVal<RunOn::Device>(0.0);
             }
 
-            const amrex::StateDescriptor* desc = state[State_Type].descriptor();
-            const auto& bcs = desc->getBCs();
-            amrex::Gpu::DeviceVector<amrex::BCRec> bcs_d(desc->nComp());
-            amrex::Gpu::copy(
-              amrex::Gpu::hostToDevice, bcs.begin(), bcs.end(), bcs_d.begin());
-
             const auto& dxInv = geom.InvCellSizeArray();
 
-            // Return hyd_src - centered at half-time if using Godunov method
-            //                - centered at  old-time if using MOL method
-            //
-            // The dt we pass in here is used if (do_mol == 0), i.e.
-            //      in the Godunov prediction, but also if we do StateRedistribution
-            //
-            CAMR_umdrv_eb(do_mol, bx, bxg_i, mfi, geom, &ebfact,
-                          phys_bc.lo(), phys_bc.hi(),
-                          sarr, hyd_src, qarr, qauxar, srcqarr,
-                          vfrac_arr, flag, dx, dxInv, flx_arr,
-                          a, volume.array(mfi),
-                          as_crse, p_drho_as_crse->array(), p_rrflag_as_crse->array(),
-                          as_fine, dm_as_fine.array(), level_mask.const_array(mfi),
-                          dt, ppm_type, plm_iorder, use_pslope,
-                          use_flattening, transverse_reset_density,
-                          small, small_dens, small_pres, difmag,
-                          bcs_d.data(), redistribution_type, eb_weights_type);
+            // The tile was split in buildEBTileInfo so that only the sub-boxes
+            // whose redistribution neighborhood contains cut or covered cells
+            // take the EB path; the rest use the regular kernels, exactly as a
+            // regular tile would. The flux and redistribution arrays span the
+            // whole tile, so the flux register calls below still see every
+            // face of it.
+            for (const Box& sbx : eb_info.regular_boxes) {
+                CAMR_umdrv(do_mol, sbx, geom, phys_bc.lo(), phys_bc.hi(),
+                           sarr, hyd_src, qarr, qauxar, srcqarr, dx,
+                           dt_tile, lev_ppm_type, plm_iorder, use_pslope,
+                           use_flattening, transverse_reset_density, riemann_type,
+                           sweep_order, small, small_dens, small_pres, difmag,
+                           flx_arr, area, vol);
+            }
+
+            // A face shared by a regular and a cut sub-box is owned by the cut
+            // sub-box, which overwrites it below. The regular fluxes are kept
+            // so that the regular cells can be brought onto the same flux.
+            const bool mixed_tile = !eb_info.regular_boxes.empty() && !eb_info.cut_boxes.empty();
+            amrex::GpuArray<amrex::FArrayBox, AMREX_SPACEDIM> flux_regular;
+            if (mixed_tile) {
+                for (int dir = 0; dir < AMREX_SPACEDIM; ++dir) {
+                    flux_regular[dir].resize(flux[dir].box(), NVAR, amrex::The_Async_Arena());
+                    flux_regular[dir].copy<RunOn::Device>(flux[dir]);
+                }
+            }
+
+            for (const Box& sbx : eb_info.cut_boxes) {
+                const Box& sbxg_i = grow(sbx,ngrow_bx);
+                // Return hyd_src - centered at half-time if using Godunov method
+                //                - centered at  old-time if using MOL method
+                //
+                // The dt we pass in here is used if (do_mol == 0), i.e.
+                //      in the Godunov prediction, but also if we do StateRedistribution
+                //
+                CAMR_umdrv_eb(do_mol, sbx, sbxg_i, geom,
+                              phys_bc.lo(), phys_bc.hi(),
+                              sarr, hyd_src, qarr, qauxar, srcqarr,
+                              vfrac_arr, flag, eb_info.ccent, eb_info.apert, eb_info.fcent,
+                              dx, dxInv, flx_arr, vol,
+                              as_crse, p_drho_as_crse->array(), p_rrflag_as_crse->array(),
+                              as_fine, dm_as_fine.array(), level_mask.const_array(mfi),
+                              fac_for_reflux, dt_tile, lev_ppm_type, plm_iorder, use_pslope,
+                              use_flattening, transverse_reset_density, riemann_type,
+                              small, small_dens, small_pres, difmag,
+                              eb_bcs_d.data(), redistribution_type, eb_weights_type);
+            }
+
+            // The flux differences are zero except on the faces the cut
+            // sub-boxes took over, so this only corrects the regular cells
+            // next to them (see CAMR_update for the sign)
+            if (mixed_tile) {
+                const Real volinv = 1.0 / vol;
+                const GpuArray<Array4<const Real>, AMREX_SPACEDIM> flx_reg{
+                    {AMREX_D_DECL(flux_regular[0].const_array(), flux_regular[1].const_array(),
+                                  flux_regular[2].const_array())}};
+                for (const Box& sbx : eb_info.regular_boxes) {
+                    ParallelFor(sbx, NVAR, [=] AMREX_GPU_DEVICE(int i, int j, int k, int n) noexcept {
+                        hyd_src(i, j, k, n) +=
+                            (AMREX_D_TERM(
+                                 (flx_arr[0](i, j, k, n) - flx_reg[0](i, j, k, n))
+                               - (flx_arr[0](i + 1, j, k, n) - flx_reg[0](i + 1, j, k, n)),
+                               + (flx_arr[1](i, j, k, n) - flx_reg[1](i, j, k, n))
+                               - (flx_arr[1](i, j + 1, k, n) - flx_reg[1](i, j + 1, k, n)),
+                               + (flx_arr[2](i, j, k, n) - flx_reg[2](i, j, k, n))
+                               - (flx_arr[2](i, j, k + 1, n) - flx_reg[2](i, j, k + 1, n)))) * volinv;
+                    });
+                }
+            }
 
             //
-            // Here fac_for_reflux = 1.0 if doing Godunov, 0.5 if doing MOL
+            // Here fac_for_reflux = 1.0 if doing Godunov, the weight of this
+            // stage in the Runge-Kutta step if doing MOL
             //
             if (do_reflux) {
                 if (level < finest_level) {
@@ -219,15 +383,19 @@ CAMR::construct_hydro_source (const MultiFab& S,
             // Note that the dt here is only used if (do_mol == 0), i.e.
             //      in the Godunov prediction
             //
-            CAMR_umdrv(do_mol, bx, geom, phys_bc.lo(), phys_bc.hi(),
-                       sarr, hyd_src, qarr, qauxar, srcqarr, dx,
-                       dt, ppm_type, plm_iorder, use_pslope,
-                       use_flattening, transverse_reset_density,
-                       small, small_dens, small_pres, difmag,
-                       flx_arr, a, volume.array(mfi));
+            const Vector<Box> whole_tile{bx};
+            for (const Box& sbx : (work_boxes) ? *work_boxes : whole_tile) {
+                CAMR_umdrv(do_mol, sbx, geom, phys_bc.lo(), phys_bc.hi(),
+                           sarr, hyd_src, qarr, qauxar, srcqarr, dx,
+                           dt_tile, lev_ppm_type, plm_iorder, use_pslope,
+                           use_flattening, transverse_reset_density, riemann_type,
+                           sweep_order, small, small_dens, small_pres, difmag,
+                           flx_arr, area, vol);
+            }
 
             //
-            // Here fac_for_reflux = 1.0 if doing Godunov, 0.5 if doing MOL
+            // Here fac_for_reflux = 1.0 if doing Godunov, the weight of this
+            // stage in the Runge-Kutta step if doing MOL
             //
             if (do_reflux) {
                 if (level < finest_level) {
@@ -246,11 +414,216 @@ CAMR::construct_hydro_source (const MultiFab& S,
         } // regular
 #endif
 
+        } // do_hydro
+
+        // The whole stage update of the tile in one pass, while the hydro
+        // update is still in cache:
+        //   S_new = alpha S_old + (1 - alpha) (S + beta dt (dSdt + old sources))
+        // with dt the tile's own pseudo-timestep under local time stepping
+        {
+            auto const& sarr  = S.const_array(mfi);
+            auto const& sold  = S_old.const_array(mfi);
+            auto const& snew  = S_new.array(mfi);
+            auto const& hydro = dsdt.const_array();
+            GpuArray<Array4<const Real>, num_src> srcs;
+            for (int n = 0; n < nsrc; ++n) {
+                srcs[n] = old_sources[src_list[n]]->const_array(mfi);
+            }
+            // dU/dt of component n
+            auto dudt = [=] AMREX_GPU_DEVICE(int i, int j, int k, int n) noexcept -> Real {
+                Real src = 0.0;
+                for (int m = 0; m < nsrc; ++m) {
+                    if (slots[m][n] >= 0) {
+                        src += srcs[m](i, j, k, slots[m][n]);
+                    }
+                }
+                return hydro(i, j, k, n) + src;
+            };
+            ParallelFor(bx, NVAR, [=] AMREX_GPU_DEVICE(int i, int j, int k, int n) noexcept {
+                snew(i, j, k, n) = alpha * sold(i, j, k, n)
+                    + (1.0 - alpha) * (sarr(i, j, k, n) + beta * dt_tile * dudt(i, j, k, n));
+            });
+            if (track_residual) {
+                const bool use_mask = (res_mask != nullptr);
+                const auto& mask = use_mask ? res_mask->const_array(mfi) : Array4<Real const>{};
+#ifdef AMREX_USE_EB
+                const auto& vfrac = eb_info.vfrac;
+#endif
+                res_op.eval(bx, res_data, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept -> ResTuple {
+                    Real w = use_mask ? mask(i, j, k) : 1.0;
 #ifdef AMREX_USE_EB
-        } // not covered
+                    w *= vfrac(i, j, k);
 #endif
+                    if (w > 0.0) {
+                        const Real r = std::abs(dudt(i, j, k, URHO));
+                        return {w * r, w * r * r, r, w};
+                    }
+                    return {0.0, 0.0, 0.0, 0.0};
+                });
+            }
+        }
       } // mfi
     } // openmp
 
     BL_PROFILE_VAR_STOP(PC_UMDRV);
+
+    if (track_residual) {
+        auto const& res = res_data.value(res_op);
+        Real sums[3] = {amrex::get<0>(res), amrex::get<1>(res), amrex::get<3>(res)};
+        Real res_max = amrex::get<2>(res);
+        ParallelDescriptor::ReduceRealSum(sums, 3);
+        ParallelDescriptor::ReduceRealMax(res_max);
+
+        // Volume of the uncovered cells, in cells
+        const Real ncells = amrex::max(sums[2], std::numeric_limits<Real>::min());
+        residual_norm[0] = sums[0] / ncells;
+        residual_norm[1] = std::sqrt(sums[1] / ncells);
+        residual_norm[2] = res_max;
+        residual_ref = amrex::max(residual_ref, residual_norm[1]);
+        have_residual = true;
+
+        if (verbose) {
+            amrex::Print() << "... Level " << level << " density residual: L1 = "
+                           << residual_norm[0] << ", L2 = " << residual_norm[1]
+                           << ", Linf = " << residual_norm[2] << std::endl;
+        }
+    }
+}
+
+void
+CAMR::findQuiescentTiles (const MultiFab& S, Real alpha, int first_update)
+{
+  // Mark the hydro tiles whose whole stencil holds one uniform state in
+  // tile_skipped. A tile that was skipped in the last update stays skipped
+  // if no tile its stencil reaches changed since, and a tile none of whose
+  // neighbors was left unchanged is not checked, since a uniform state only
+  // spreads in from quiescent tiles. The remaining tiles are checked on
+  // the device with a single copy of the results to the host.
+
+    BL_PROFILE("CAMR::findQuiescentTiles()");
+
+    const int finest_level = parent->finestLevel();
+    const bool skip_covered = skip_covered_hydro && level < finest_level;
+
+    // avgDown overwrites the cells under the finer grids after every step,
+    // refluxing or not
+    BoxArray crse_fine_grids;
+    if (level < finest_level) {
+        crse_fine_grids = parent->boxArray(level + 1);
+        crse_fine_grids.coarsen(parent->refRatio(level));
+    }
+    const std::vector<IntVect> pshifts = geom.periodicity().shiftIntVect();
+
+    if (quiescent_nbrs.empty()) {
+        buildQuiescentNbrs();
+    }
+    const int ntiles = static_cast<int>(quiescent_nbrs.size());
+
+    // Sources and reactions change the state outside of the hydro update,
+    // and new finer grids change which tiles feed the flux registers and
+    // are averaged down onto
+    BoxArray fine_grids;
+    if (level < finest_level) {
+        fine_grids = parent->boxArray(level + 1);
+    }
+    const bool reuse = src_list.empty() && !do_react &&
+        static_cast<int>(tile_changed.size()) == ntiles &&
+        fine_grids == quiescent_fine_grids;
+    quiescent_fine_grids = fine_grids;
+    if (!reuse) {
+        tile_changed.assign(ntiles, 1);
+        tile_moved.assign(ntiles, 1);
+    }
+
+    const amrex::MFItInfo tiling = hydroTiling();
+
+    tile_skipped.assign(ntiles, 0);
+    Vector<int> check(ntiles, 0);
+    for (MFIter mfi(S, tiling); mfi.isValid(); ++mfi) {
+        const int t = mfi.LocalTileIndex();
+        if (skip_covered && hydro_work_boxes[t].empty()) {
+            continue;
+        }
+#ifdef AMREX_USE_EB
+        if (eb_tile_info[t].type != FabType::regular) {
+            continue;
+        }
+#endif
+
+        // A tile that avgDown writes into is never skipped, which also
+        // marks it as changed for its neighbors
+        const Box& bx = mfi.tilebox();
+        if (level < finest_level && crse_fine_grids.intersects(bx)) {
+            continue;
+        }
+
+        // A quiescent tile is only skipped if none of its faces go into a
+        // flux register
+        const Box& gbx = amrex::grow(bx, 1);
+        bool feeds_reg = false;
+        if (do_reflux && level > 0) {
+            feeds_reg = !grids.contains(gbx);
+        }
+        if (do_reflux && level < finest_level) {
+            for (const auto& iv : pshifts) {
+                feeds_reg = feeds_reg || crse_fine_grids.intersects(gbx + iv);
+            }
+        }
+        if (feeds_reg) {
+            continue;
+        }
+
+        const Vector<int>& nbrs = quiescent_nbrs[t];
+        if (reuse && !nbrs.empty()) {
+            int nquiet = 0;
+            for (int nb : nbrs) {
+                nquiet += 1 - tile_changed[nb];
+            }
+            if (nquiet == static_cast<int>(nbrs.size())) {
+                tile_skipped[t] = 1;
+                continue;
+            }
+            if (nquiet == 0) {
+                continue;
+            }
+        }
+        check[t] = 1;
+    }
+
+    Gpu::DeviceVector<int> nonuniform(ntiles, 0);
+    int* p_nonuniform = nonuniform.data();
+#ifdef _OPENMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+    for (MFIter mfi(S, tiling); mfi.isValid(); ++mfi) {
+        const int t = mfi.LocalTileIndex();
+        if (!check[t]) {
+            continue;
+        }
+        auto const& s = S.const_array(mfi);
+        const Box& qbx = amrex::grow(mfi.tilebox(), numGrow());
+        const IntVect ref = qbx.smallEnd();
+        ParallelFor(qbx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
+            for (int n = 0; n < NVAR; ++n) {
+                if (s(i, j, k, n) != s(ref, n)) {
+                    p_nonuniform[t] = 1;
+                    break;
+                }
+            }
+        });
+    }
+    Vector<int> h_nonuniform(ntiles);
+    Gpu::copy(Gpu::deviceToHost, nonuniform.begin(), nonuniform.end(), h_nonuniform.begin());
+    Gpu::streamSynchronize();
+
+    for (int t = 0; t < ntiles; ++t) {
+        if (check[t]) {
+            tile_skipped[t] = !h_nonuniform[t];
+        }
+        // A skipped tile is left at alpha S_old + (1 - alpha) S, which is
+        // its stage state unless it moved earlier in the step
+        const int moved = first_update ? 0 : tile_moved[t];
+        tile_changed[t] = !tile_skipped[t] || (alpha != 0.0 && moved);
+        tile_moved[t] = moved || tile_changed[t];
+    }
 }
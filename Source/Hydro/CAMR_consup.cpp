@@ -14,13 +14,14 @@ CAMR_consup(
     Box const& bx,
     Array4<Real> const& update,
     const amrex::GpuArray<const Array4<     Real>, AMREX_SPACEDIM> flx,
-    Array4<const Real> const& vol,
+    const Real vol,
     Array4<const Real> const& pdivu)
 {
     // Take divergence of fluxes to define conservative update
+    const Real volinv = 1.0 / vol;
     amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept
     {
-        CAMR_update(i,j,k,update,flx,vol,pdivu);
+        CAMR_update(i,j,k,update,flx,volinv,pdivu);
     });
 }
 
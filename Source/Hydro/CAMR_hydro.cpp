@@ -22,13 +22,15 @@ CAMR_umdrv (bool do_mol, Box const& bx,
             const int use_pslope,
             const int use_flattening,
             const int transverse_reset_density,
+            const int riemann_type,
+            const int sweep_order,
             const Real small,
             const Real small_dens,
             const Real small_pres,
             const Real l_difmag,
             const amrex::GpuArray<const Array4<Real>, AMREX_SPACEDIM> flx,
-            const amrex::GpuArray<const Array4<const Real>, AMREX_SPACEDIM> a,
-            Array4<Real> const& vol)
+            const amrex::GpuArray<Real, AMREX_SPACEDIM> a,
+            const Real vol)
 {
     BL_PROFILE_VAR("CAMR::umdrv()", umdrv);
 
@@ -56,16 +58,28 @@ CAMR_umdrv (bool do_mol, Box const& bx,
                   AMREX_D_DECL(flx[0], flx[1], flx[2]),
                   AMREX_D_DECL(qec_arr[0], qec_arr[1], qec_arr[2]),
                   AMREX_D_DECL(a[0], a[1], a[2]), pdivuarr, vol,
-                  small, small_dens, small_pres, plm_iorder);
+                  small, small_dens, small_pres, plm_iorder, riemann_type);
 
+#if (AMREX_SPACEDIM == 3)
+    } else if (sweep_order >= 0) {
+        // Split sweeps, in the order sweep_order selects
+        Godunov_umeth_split(bx, bclo, bchi, domlo, domhi, uin_arr, q_arr, qaux_arr, src_q,
+                            flx[0], flx[1], flx[2], qec_arr[0], qec_arr[1], qec_arr[2],
+                            a[0], a[1], a[2], pdivuarr, vol, dx, dt,
+                            small, small_dens, small_pres, ppm_type, use_pslope, use_flattening,
+                            plm_iorder, riemann_type, sweep_order);
+#endif
     } else {
+#if (AMREX_SPACEDIM != 3)
+        amrex::ignore_unused(sweep_order);
+#endif
         Godunov_umeth(bx, bclo, bchi, domlo, domhi, q_arr, qaux_arr, src_q,
                       AMREX_D_DECL(flx[0], flx[1], flx[2]),
                       AMREX_D_DECL(qec_arr[0], qec_arr[1], qec_arr[2]),
                       AMREX_D_DECL(a[0], a[1], a[2]),
                       pdivuarr, vol, dx, dt,
                       small, small_dens, small_pres, ppm_type, use_pslope, use_flattening,
-                      plm_iorder, transverse_reset_density);
+                      plm_iorder, transverse_reset_density, riemann_type);
     }
 
     // Construct divu
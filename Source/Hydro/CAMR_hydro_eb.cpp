@@ -13,9 +13,8 @@ using namespace amrex;
 #ifdef AMREX_USE_EB
 void
 CAMR_umdrv_eb( const bool do_mol, Box const& bx,
-               Box const& bxg_i, const MFIter& mfi,
+               Box const& bxg_i,
                Geometry const& geom,
-               const EBFArrayBoxFactory* ebfact,
                const int* bclo, const int* bchi,
                Array4<const Real> const& uin_arr,
                Array4<      Real> const& dsdt_arr,
@@ -24,23 +23,27 @@ CAMR_umdrv_eb( const bool do_mol, Box const& bx,
                Array4<const Real> const& src_q,
                Array4<const Real> const& vf_arr,
                Array4<EBCellFlag const> const& flag_arr,
+               Array4<Real const> const& ccc,
+               const GpuArray<Array4<Real const>, AMREX_SPACEDIM>& apert,
+               const GpuArray<Array4<Real const>, AMREX_SPACEDIM>& fcent,
                const GpuArray<Real, AMREX_SPACEDIM> dx,
                const GpuArray<Real, AMREX_SPACEDIM> dxinv,
                const GpuArray<const Array4<Real>, AMREX_SPACEDIM>& flux_arr,
-               const amrex::GpuArray<const Array4<const Real>, AMREX_SPACEDIM> a,
-               Array4<Real> const& vol,
+               const Real vol,
                int as_crse,
                Array4<Real> const& drho_as_crse,
                Array4<int const> const& rrflag_as_crse,
                int as_fine,
                Array4<Real> const& dm_as_fine,
                Array4<int const> const& lev_mask,
+               const Real fac_for_redist,
                const Real dt,
                const int ppm_type,
                const int plm_iorder,
                const int use_pslope,
                const int use_flattening,
                const int transverse_reset_density,
+               const int riemann_type,
                const Real small,
                const Real small_dens,
                const Real small_pres,
@@ -53,14 +56,8 @@ CAMR_umdrv_eb( const bool do_mol, Box const& bx,
 
     const Box& bxg_ii = grow(bxg_i,1);
 
-    Array4<Real const> AMREX_D_DECL(fcx, fcy, fcz), AMREX_D_DECL(apx, apy, apz), ccc;
-    AMREX_D_TERM(fcx = ebfact->getFaceCent()[0]->const_array(mfi);,
-                 fcy = ebfact->getFaceCent()[1]->const_array(mfi);,
-                 fcz = ebfact->getFaceCent()[2]->const_array(mfi););
-    AMREX_D_TERM(apx = ebfact->getAreaFrac()[0]->const_array(mfi);,
-                 apy = ebfact->getAreaFrac()[1]->const_array(mfi);,
-                 apz = ebfact->getAreaFrac()[2]->const_array(mfi););
-    ccc = ebfact->getCentroid().const_array(mfi);
+    Array4<Real const> AMREX_D_DECL(fcx = fcent[0], fcy = fcent[1], fcz = fcent[2]);
+    Array4<Real const> AMREX_D_DECL(apx = apert[0], apy = apert[1], apz = apert[2]);
 
     const int* domlo = geom.Domain().loVect();
     const int* domhi = geom.Domain().hiVect();
@@ -121,7 +118,7 @@ CAMR_umdrv_eb( const bool do_mol, Box const& bx,
         MOL_umeth_eb(bx, bclo, bchi, domlo, domhi, q_arr, qaux_arr, divc_arr,
                      AMREX_D_DECL(qec_arr[0], qec_arr[1], qec_arr[2]), vf_arr,
                      flag_arr, dx, flux_tmp_arr, small, small_dens, small_pres,
-                     plm_iorder, l_eb_weights_type);
+                     plm_iorder, riemann_type, l_eb_weights_type);
     } else {
         Godunov_umeth_eb(bx, bclo, bchi, domlo, domhi, q_arr, qaux_arr, src_q,
                          AMREX_D_DECL(flux_tmp_arr[0], flux_tmp_arr[1], flux_tmp_arr[2]),
@@ -129,7 +126,7 @@ CAMR_umdrv_eb( const bool do_mol, Box const& bx,
                          AMREX_D_DECL(apx, apy, apz),
                          pdivuarr, vol, vf_arr, flag_arr, dx, dt,
                          small, small_dens, small_pres, ppm_type, use_pslope, use_flattening,
-                         plm_iorder, transverse_reset_density);
+                         plm_iorder, transverse_reset_density, riemann_type);
     }
 
     // Construct divu
@@ -169,7 +166,6 @@ CAMR_umdrv_eb( const bool do_mol, Box const& bx,
     int level_mask_not_covered = CAMRConstants::level_mask_notcovered;
     bool use_wts_in_divnc = false;
 
-    Real fac_for_redist = (do_mol) ? Real(0.5) : Real(1.0);
     ApplyMLRedistribution(bx, l_ncomp,
                           dsdt_arr, divc_arr, uin_arr, redistwgt_arr,
                           flag_arr,
@@ -21,10 +21,10 @@ Godunov_umeth (
   amrex::Array4<amrex::Real> const& flx2,
   amrex::Array4<amrex::Real> const& q1,
   amrex::Array4<amrex::Real> const& q2,
-  amrex::Array4<const amrex::Real> const& a1,
-  amrex::Array4<const amrex::Real> const& a2,
+  const amrex::Real a1,
+  const amrex::Real a2,
   amrex::Array4<amrex::Real> const& pdivu,
-  amrex::Array4<const amrex::Real> const& vol,
+  const amrex::Real vol,
   const amrex::GpuArray<amrex::Real, AMREX_SPACEDIM> del,
   const amrex::Real dt,
   const amrex::Real small,
@@ -34,7 +34,8 @@ Godunov_umeth (
   const int use_pslope,
   const int use_flattening,
   const int iorder,
-  const int l_transverse_reset_density)
+  const int l_transverse_reset_density,
+  const int riemann_type)
 {
   BL_PROFILE("CAMR::Godunov_umeth()");
   amrex::Real const dx = del[0];
@@ -74,20 +75,42 @@ Godunov_umeth (
   auto const& qyparr = qyp.array();
 
   const PassMap* lpmap = CAMR::d_pass_map;
-  if (ppm_type == 0) {
+
+  // Flattening coefficient of each cell, shared by the traces of all the
+  // directions
+  amrex::FArrayBox flatfab(bxg2, 1, amrex::The_Async_Arena());
+  auto const& flatarr = flatfab.array();
+  flatten_box(bxg2, q, flatarr, use_flattening);
+
+  // In the hybrid reconstruction (ppm_type = 2) only the cells near shocks
+  // are traced with PPM, and the rest with PLM
+  amrex::IArrayBox ppm_cells_fab;
+  amrex::FArrayBox sensfab;
+  amrex::Array4<int const> ppm_cells;
+  if (ppm_type == 2) {
+    amrex::Array4<const amrex::Real> sens = flatarr;
+    if (use_flattening != 1) {
+      sensfab.resize(bxg2, 1, amrex::The_Async_Arena());
+      flatten_box(bxg2, q, sensfab.array(), 1);
+      sens = sensfab.const_array();
+    }
+    ppm_cells_fab.resize(bxg2, 1, amrex::The_Async_Arena());
+    hybrid_ppm_cells(bxg2, sens, ppm_cells_fab.array());
+    ppm_cells = ppm_cells_fab.const_array();
+  }
+
+  if (ppm_type == 0 || ppm_type == 2) {
     amrex::ParallelFor(
       bxg2, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
 
         amrex::Real slope[QVAR];
 
-        amrex::Real flat = 1.0;
-        // Calculate flattening in-place
-        if (use_flattening == 1) {
-          for (int dir_flat = 0; dir_flat < AMREX_SPACEDIM; dir_flat++) {
-            flat = std::min(flat, flatten(i, j, k, dir_flat, q));
-          }
+        if (ppm_cells && ppm_cells(i, j, k) != 0) {
+          return;
         }
 
+        const amrex::Real flat = flatarr(i, j, k);
+
         // X slopes and interp
 
         for (int n = 0; n < QVAR; ++n)
@@ -114,7 +137,8 @@ Godunov_umeth (
           small_dens, small_pres, *lpmap);
       });
 
-  } else if (ppm_type == 1) {
+  }
+  if (ppm_type == 1 || ppm_type == 2) {
 
     // Compute the normal interface states by reconstructing
     // the primitive variables using the piecewise parabolic method
@@ -123,16 +147,13 @@ Godunov_umeth (
 
     int idir = 0;
     trace_ppm(
-      bxg2, idir, q, qaux, srcQ, qxmarr, qxparr, bxg2, dt, del, use_flattening,
-      small_dens, small_pres, lpmap);
+      bxg2, idir, q, qaux, srcQ, qxmarr, qxparr, bxg2, dt, del, flatarr,
+      small_dens, small_pres, lpmap, ppm_cells);
 
     idir = 1;
     trace_ppm(
-      bxg2, idir, q, qaux, srcQ, qymarr, qyparr, bxg2, dt, del, use_flattening,
-      small_dens, small_pres, lpmap);
-
-  } else {
-    amrex::Error("CAMR::ppm_type must be 0 (PLM) or 1 (PPM)");
+      bxg2, idir, q, qaux, srcQ, qymarr, qyparr, bxg2, dt, del, flatarr,
+      small_dens, small_pres, lpmap, ppm_cells);
   }
 
   // These are the first flux estimates as per the corner-transport-upwind
@@ -142,21 +163,17 @@ Godunov_umeth (
   auto const& fxarr = fx.array();
   amrex::FArrayBox qgdx(bxg2, NGDNV, amrex::The_Async_Arena());
   auto const& gdtemp = qgdx.array();
-  amrex::ParallelFor(xflxbx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept
-  {
-        CAMR_cmpflx(i, j, k, bclx, bchx, dlx, dhx, qxmarr, qxparr, fxarr, gdtemp, qaux,
-                    cdir, *lpmap, small, small_dens, small_pres);
-  });
+  CAMR_cmpflx_box(
+    xflxbx, bclx, bchx, dlx, dhx, qxmarr, qxparr, fxarr, gdtemp, qaux,
+    cdir, riemann_type, small, small_dens, small_pres);
 
   // Y initial fluxes
   cdir = 1;
   amrex::FArrayBox fy(yflxbx, NVAR, amrex::The_Async_Arena());
   auto const& fyarr = fy.array();
-  amrex::ParallelFor( yflxbx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept
-  {
-      CAMR_cmpflx(i, j, k, bcly, bchy, dly, dhy, qymarr, qyparr, fyarr, q2, qaux,
-                  cdir, *lpmap, small, small_dens, small_pres);
-  });
+  CAMR_cmpflx_box(
+    yflxbx, bcly, bchy, dly, dhy, qymarr, qyparr, fyarr, q2, qaux,
+    cdir, riemann_type, small, small_dens, small_pres);
 
   // X interface corrections
   cdir = 0;
@@ -175,10 +192,9 @@ Godunov_umeth (
   const amrex::Box& xfxbx = surroundingNodes(bx, cdir);
 
   // Final Riemann problem X
-  amrex::ParallelFor(xfxbx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
-      CAMR_cmpflx(i, j, k, bclx, bchx, dlx, dhx, qmarr, qparr, flx1, q1, qaux,
-                  cdir, *lpmap, small, small_dens, small_pres);
-  });
+  CAMR_cmpflx_box(
+    xfxbx, bclx, bchx, dlx, dhx, qmarr, qparr, flx1, q1, qaux,
+    cdir, riemann_type, small, small_dens, small_pres);
 
   // Y interface corrections
   cdir = 1;
@@ -192,15 +208,14 @@ Godunov_umeth (
 
   // Final Riemann problem Y
   const amrex::Box& yfxbx = surroundingNodes(bx, cdir);
-  amrex::ParallelFor(yfxbx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept
-  {
-      CAMR_cmpflx(i, j, k, bcly, bchy, dly, dhy, qmarr, qparr, flx2, q2, qaux,
-                  cdir, *lpmap, small, small_dens, small_pres);
-  });
+  CAMR_cmpflx_box(
+    yfxbx, bcly, bchy, dly, dhy, qmarr, qparr, flx2, q2, qaux,
+    cdir, riemann_type, small, small_dens, small_pres);
 
   // Construct p div{U}
+  const amrex::Real volinv = 1.0 / vol;
   amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
-    CAMR_pdivu(i, j, k, pdivu, q1, q2, a1, a2, vol);
+    CAMR_pdivu(i, j, k, pdivu, q1, q2, a1, a2, volinv);
   });
 }
 #endif
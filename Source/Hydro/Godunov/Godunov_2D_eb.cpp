@@ -24,7 +24,7 @@ Godunov_umeth_eb (
   amrex::Array4<const amrex::Real> const& a1,
   amrex::Array4<const amrex::Real> const& a2,
   amrex::Array4<amrex::Real> const& pdivu,
-  amrex::Array4<const amrex::Real> const& vol,
+  const amrex::Real vol,
   amrex::Array4<const amrex::Real> const& /*vfrac*/,
   amrex::Array4<amrex::EBCellFlag const> const& flag_arr,
   const amrex::GpuArray<amrex::Real, AMREX_SPACEDIM> del,
@@ -36,7 +36,8 @@ Godunov_umeth_eb (
   const int use_pslope,
   const int use_flattening,
   const int iorder,
-  const int l_transverse_reset_density)
+  const int l_transverse_reset_density,
+  const int riemann_type)
 {
   BL_PROFILE("CAMR::Godunov_umeth_2D_eb()");
 
@@ -77,7 +78,34 @@ Godunov_umeth_eb (
   auto const& qyparr = qyp.array();
 
   const PassMap* lpmap = CAMR::d_pass_map;
-  if (ppm_type == 0) {
+
+  // Flattening coefficient of each cell, shared by the traces of all the
+  // directions; PLM uses the EB-aware one
+  amrex::FArrayBox flatfab(bxg2, 1, amrex::The_Async_Arena());
+  auto const& flatarr = flatfab.array();
+  if (ppm_type != 1) {
+    flatten_box_eb(bxg2, flag_arr, q, flatarr, use_flattening);
+  } else {
+    flatten_box(bxg2, q, flatarr, use_flattening);
+  }
+
+  // In the hybrid reconstruction (ppm_type = 2) only the cells near shocks
+  // are traced with PPM, and the rest with PLM
+  amrex::IArrayBox ppm_cells_fab;
+  amrex::FArrayBox sensfab;
+  amrex::Array4<int const> ppm_cells;
+  if (ppm_type == 2) {
+    amrex::Array4<const amrex::Real> sens = flatarr;
+    if (use_flattening != 1) {
+      sensfab.resize(bxg2, 1, amrex::The_Async_Arena());
+      flatten_box(bxg2, q, sensfab.array(), 1);
+      sens = sensfab.const_array();
+    }
+    ppm_cells_fab.resize(bxg2, 1, amrex::The_Async_Arena());
+    hybrid_ppm_cells(bxg2, sens, ppm_cells_fab.array());
+    ppm_cells = ppm_cells_fab.const_array();
+  }
+  if (ppm_type == 0 || ppm_type == 2) {
     amrex::ParallelFor(
       bxg2, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept
     {
@@ -87,13 +115,11 @@ Godunov_umeth_eb (
 
         amrex::Real slope[QVAR];
 
-        amrex::Real flat = 1.0;
-       // Calculate flattening in-place
-       if (use_flattening == 1) {
-         for (int dir_flat = 0; dir_flat < AMREX_SPACEDIM; dir_flat++) {
-           flat = std::min(flat, flatten_eb(i, j, k, dir_flat, flag_arr, q));
-         }
-       }
+        if (ppm_cells && ppm_cells(i, j, k) != 0) {
+          return;
+        }
+
+        const amrex::Real flat = flatarr(i, j, k);
 
         // X slopes and interp
 
@@ -121,7 +147,8 @@ Godunov_umeth_eb (
           small_dens, small_pres, *lpmap, a2);
       });
 
-  } else if (ppm_type == 1) {
+  }
+  if (ppm_type == 1 || ppm_type == 2) {
 
     // Compute the normal interface states by reconstructing
     // the primitive variables using the piecewise parabolic method
@@ -130,16 +157,13 @@ Godunov_umeth_eb (
 
     int idir = 0;
     trace_ppm(
-      bxg2, idir, q, qaux, srcQ, qxmarr, qxparr, bxg2, dt, del, use_flattening,
-      small_dens, small_pres, lpmap);
+      bxg2, idir, q, qaux, srcQ, qxmarr, qxparr, bxg2, dt, del, flatarr,
+      small_dens, small_pres, lpmap, ppm_cells);
 
     idir = 1;
     trace_ppm(
-      bxg2, idir, q, qaux, srcQ, qymarr, qyparr, bxg2, dt, del, use_flattening,
-      small_dens, small_pres, lpmap);
-
-  } else {
-    amrex::Error("CAMR::ppm_type must be 0 (PLM) or 1 (PPM)");
+      bxg2, idir, q, qaux, srcQ, qymarr, qyparr, bxg2, dt, del, flatarr,
+      small_dens, small_pres, lpmap, ppm_cells);
   }
 
   // These are the first flux estimates as per the corner-transport-upwind
@@ -154,7 +178,7 @@ Godunov_umeth_eb (
     {
         if (!flag_arr(i,j,k).isCovered() && !flag_arr(i-1,j,k).isCovered()) {
             CAMR_cmpflx(i, j, k, bclx, bchx, dlx, dhx, qxmarr, qxparr, fxarr, gdtemp, qaux,
-                        cdir, *lpmap, small, small_dens, small_pres);
+                        cdir, riemann_type, small, small_dens, small_pres);
         }
     });
 
@@ -166,7 +190,7 @@ Godunov_umeth_eb (
   {
       if (!flag_arr(i,j,k).isCovered() && !flag_arr(i,j-1,k).isCovered()) {
           CAMR_cmpflx(i, j, k, bcly, bchy, dly, dhy, qymarr, qyparr, fyarr, q2, qaux,
-                      cdir, *lpmap, small, small_dens, small_pres);
+                      cdir, riemann_type, small, small_dens, small_pres);
       }
   });
 
@@ -193,7 +217,7 @@ Godunov_umeth_eb (
   {
       if (!flag_arr(i,j,k).isCovered() && !flag_arr(i,j-1,k).isCovered()) {
           CAMR_cmpflx(i, j, k, bclx, bchx, dlx, dhx, qmarr, qparr, flx1, q1, qaux,
-                      cdir, *lpmap, small, small_dens, small_pres);
+                      cdir, riemann_type, small, small_dens, small_pres);
       }
   });
 
@@ -215,14 +239,15 @@ Godunov_umeth_eb (
   {
       if (!flag_arr(i,j,k).isCovered() && !flag_arr(i,j-1,k).isCovered()) {
           CAMR_cmpflx(i, j, k, bcly, bchy, dly, dhy, qmarr, qparr, flx2, q2, qaux,
-                      cdir, *lpmap, small, small_dens, small_pres);
+                      cdir, riemann_type, small, small_dens, small_pres);
       }
   });
 
-  // Construct p div{U}
+  // Construct p div{U}; only regular cells, which have full face areas
+  const amrex::Real volinv = 1.0 / vol;
   amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
       if (flag_arr(i,j,k).isRegular()) {
-          CAMR_pdivu(i, j, k, pdivu, q1, q2, a1, a2, vol);
+          CAMR_pdivu(i, j, k, pdivu, q1, q2, dy, dx, volinv);
       } else {
           pdivu(i,j,k) = amrex::Real(0.0);
       }
@@ -2,6 +2,7 @@
 #include "Godunov.H"
 #include "Godunov_utils_3D.H"
 #include "CAMR_utils_K.H"
+#include "CAMR_ctoprim.H"
 #include "Hydro_cmpflx.H"
 #include "flatten.H"
 #include "PLM.H"
@@ -24,11 +25,11 @@ Godunov_umeth (
   amrex::Array4<amrex::Real> const& q1,
   amrex::Array4<amrex::Real> const& q2,
   amrex::Array4<amrex::Real> const& q3,
-  amrex::Array4<const amrex::Real> const& a1,
-  amrex::Array4<const amrex::Real> const& a2,
-  amrex::Array4<const amrex::Real> const& a3,
+  const amrex::Real a1,
+  const amrex::Real a2,
+  const amrex::Real a3,
   amrex::Array4<amrex::Real> const& pdivu,
-  amrex::Array4<const amrex::Real> const& vol,
+  const amrex::Real vol,
   const amrex::GpuArray<amrex::Real, AMREX_SPACEDIM> del,
   const amrex::Real dt,
   const amrex::Real small,
@@ -38,7 +39,8 @@ Godunov_umeth (
   const int use_pslope,
   const int use_flattening,
   const int iorder,
-  const int l_transverse_reset_density)
+  const int l_transverse_reset_density,
+  const int riemann_type)
 {
   BL_PROFILE("CAMR::Godunov_umeth()");
 
@@ -99,21 +101,42 @@ Godunov_umeth (
 
   const PassMap* lpmap = CAMR::d_pass_map;
 
+  // Flattening coefficient of each cell, shared by the traces of all the
+  // directions
+  amrex::FArrayBox flatfab(bxg2, 1, amrex::The_Async_Arena());
+  auto const& flatarr = flatfab.array();
+  flatten_box(bxg2, q, flatarr, use_flattening);
+
+  // In the hybrid reconstruction (ppm_type = 2) only the cells near shocks
+  // are traced with PPM, and the rest with PLM
+  amrex::IArrayBox ppm_cells_fab;
+  amrex::FArrayBox sensfab;
+  amrex::Array4<int const> ppm_cells;
+  if (ppm_type == 2) {
+    amrex::Array4<const amrex::Real> sens = flatarr;
+    if (use_flattening != 1) {
+      sensfab.resize(bxg2, 1, amrex::The_Async_Arena());
+      flatten_box(bxg2, q, sensfab.array(), 1);
+      sens = sensfab.const_array();
+    }
+    ppm_cells_fab.resize(bxg2, 1, amrex::The_Async_Arena());
+    hybrid_ppm_cells(bxg2, sens, ppm_cells_fab.array());
+    ppm_cells = ppm_cells_fab.const_array();
+  }
+
   // Put the PLM and slopes in the same kernel launch to avoid unnecessary
   // launch overhead
-  if (ppm_type == 0) {
+  if (ppm_type == 0 || ppm_type == 2) {
     amrex::ParallelFor(
       bxg2, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
         amrex::Real slope[QVAR];
 
-        amrex::Real flat = 1.0;
-        // Calculate flattening in-place
-        if (use_flattening == 1) {
-           for (int dir_flat = 0; dir_flat < AMREX_SPACEDIM; dir_flat++) {
-             flat = std::min(flat, flatten(i, j, k, dir_flat, q));
-          }
+        if (ppm_cells && ppm_cells(i, j, k) != 0) {
+          return;
         }
 
+        const amrex::Real flat = flatarr(i, j, k);
+
         // X slopes and interp
         int idir = 0;
         for (int n = 0; n < QVAR; ++n) {
@@ -150,7 +173,8 @@ Godunov_umeth (
           i, j, k, idir, qzmarr, qzparr, slope, q, qaux(i, j, k, QC), dz, dt,
           l_small_dens, l_small_pres, *lpmap);
       });
-  } else if (ppm_type == 1) {
+  }
+  if (ppm_type == 1 || ppm_type == 2) {
     // Compute the normal interface states by reconstructing
     // the primitive variables using the piecewise parabolic method
     // and doing characteristic tracing.  We do not apply the
@@ -158,21 +182,18 @@ Godunov_umeth (
 
     int idir = 0;
     trace_ppm(
-      bxg2, idir, q, qaux, srcQ, qxmarr, qxparr, bxg2, dt, del, use_flattening,
-      l_small_dens, l_small_pres, lpmap);
+      bxg2, idir, q, qaux, srcQ, qxmarr, qxparr, bxg2, dt, del, flatarr,
+      l_small_dens, l_small_pres, lpmap, ppm_cells);
 
     idir = 1;
     trace_ppm(
-      bxg2, idir, q, qaux, srcQ, qymarr, qyparr, bxg2, dt, del, use_flattening,
-      l_small_dens, l_small_pres, lpmap);
+      bxg2, idir, q, qaux, srcQ, qymarr, qyparr, bxg2, dt, del, flatarr,
+      l_small_dens, l_small_pres, lpmap, ppm_cells);
 
     idir = 2;
     trace_ppm(
-      bxg2, idir, q, qaux, srcQ, qzmarr, qzparr, bxg2, dt, del, use_flattening,
-      l_small_dens, l_small_pres, lpmap);
-
-  } else {
-    amrex::Error("CAMR::ppm_type must be 0 (PLM) or 1 (PPM)");
+      bxg2, idir, q, qaux, srcQ, qzmarr, qzparr, bxg2, dt, del, flatarr,
+      l_small_dens, l_small_pres, lpmap, ppm_cells);
   }
 
   // These are the first flux estimates as per the corner-transport-upwind
@@ -182,12 +203,9 @@ Godunov_umeth (
   auto const& fxarr = fx.array();
   amrex::FArrayBox qgdx(xflxbx, NGDNV, amrex::The_Async_Arena());
   auto const& gdtempx = qgdx.array();
-  amrex::ParallelFor(
-    xflxbx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
-      CAMR_cmpflx(
-        i, j, k, bclx, bchx, dlx, dhx, qxmarr, qxparr, fxarr, gdtempx, qaux,
-        cdir, *lpmap, small, l_small_dens, l_small_pres);
-    });
+  CAMR_cmpflx_box(
+    xflxbx, bclx, bchx, dlx, dhx, qxmarr, qxparr, fxarr, gdtempx, qaux,
+    cdir, riemann_type, small, l_small_dens, l_small_pres);
 
   // Y initial fluxes
   cdir = 1;
@@ -195,12 +213,9 @@ Godunov_umeth (
   auto const& fyarr = fy.array();
   amrex::FArrayBox qgdy(yflxbx, NGDNV, amrex::The_Async_Arena());
   auto const& gdtempy = qgdy.array();
-  amrex::ParallelFor(
-    yflxbx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
-      CAMR_cmpflx(
-        i, j, k, bcly, bchy, dly, dhy, qymarr, qyparr, fyarr, gdtempy, qaux,
-        cdir, *lpmap, small, l_small_dens, l_small_pres);
-    });
+  CAMR_cmpflx_box(
+    yflxbx, bcly, bchy, dly, dhy, qymarr, qyparr, fyarr, gdtempy, qaux,
+    cdir, riemann_type, small, l_small_dens, l_small_pres);
 
   // Z initial fluxes
   cdir = 2;
@@ -208,12 +223,9 @@ Godunov_umeth (
   auto const& fzarr = fz.array();
   amrex::FArrayBox qgdz(zflxbx, NGDNV, amrex::The_Async_Arena());
   auto const& gdtempz = qgdz.array();
-  amrex::ParallelFor(
-    zflxbx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
-      CAMR_cmpflx(
-        i, j, k, bclz, bchz, dlz, dhz, qzmarr, qzparr, fzarr, gdtempz, qaux,
-        cdir, *lpmap, small, l_small_dens, l_small_pres);
-    });
+  CAMR_cmpflx_box(
+    zflxbx, bclz, bchz, dlz, dhz, qzmarr, qzparr, fzarr, gdtempz, qaux,
+    cdir, riemann_type, small, l_small_dens, l_small_pres);
 
   // X interface corrections
   cdir = 0;
@@ -252,17 +264,14 @@ Godunov_umeth (
   auto const& qxz = gdvxzfab.array();
 
   // Riemann problem X|Y X|Z
-  amrex::ParallelFor(
-    txfxbx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
-      // X|Y
-      CAMR_cmpflx(
-        i, j, k, bclx, bchx, dlx, dhx, qmxy, qpxy, flxy, qxy, qaux,
-        cdir, *lpmap, small, l_small_dens, l_small_pres);
-      // X|Z
-      CAMR_cmpflx(
-        i, j, k, bclx, bchx, dlx, dhx, qmxz, qpxz, flxz, qxz, qaux,
-        cdir, *lpmap, small, l_small_dens, l_small_pres);
-    });
+  // X|Y
+  CAMR_cmpflx_box(
+    txfxbx, bclx, bchx, dlx, dhx, qmxy, qpxy, flxy, qxy, qaux,
+    cdir, riemann_type, small, l_small_dens, l_small_pres);
+  // X|Z
+  CAMR_cmpflx_box(
+    txfxbx, bclx, bchx, dlx, dhx, qmxz, qpxz, flxz, qxz, qaux,
+    cdir, riemann_type, small, l_small_dens, l_small_pres);
   qxym.clear();
   qxyp.clear();
   qxzm.clear();
@@ -306,17 +315,14 @@ Godunov_umeth (
   auto const& qyx = gdvyxfab.array();
   auto const& qyz = gdvyzfab.array();
 
-  amrex::ParallelFor(
-    tyfxbx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
-      // Y|X
-      CAMR_cmpflx(
-        i, j, k, bcly, bchy, dly, dhy, qmyx, qpyx, flyx, qyx, qaux,
-        cdir, *lpmap, small, l_small_dens, l_small_pres);
-      // Y|Z
-      CAMR_cmpflx(
-        i, j, k, bcly, bchy, dly, dhy, qmyz, qpyz, flyz, qyz, qaux,
-        cdir, *lpmap, small, l_small_dens, l_small_pres);
-    });
+  // Y|X
+  CAMR_cmpflx_box(
+    tyfxbx, bcly, bchy, dly, dhy, qmyx, qpyx, flyx, qyx, qaux,
+    cdir, riemann_type, small, l_small_dens, l_small_pres);
+  // Y|Z
+  CAMR_cmpflx_box(
+    tyfxbx, bcly, bchy, dly, dhy, qmyz, qpyz, flyz, qyz, qaux,
+    cdir, riemann_type, small, l_small_dens, l_small_pres);
   qyxm.clear();
   qyxp.clear();
   qyzm.clear();
@@ -363,17 +369,14 @@ Godunov_umeth (
   auto const& qzx = gdvzxfab.array();
   auto const& qzy = gdvzyfab.array();
 
-  amrex::ParallelFor(
-    tzfxbx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
-      // Z|X
-      CAMR_cmpflx(
-        i, j, k, bclz, bchz, dlz, dhz, qmzx, qpzx, flzx, qzx, qaux,
-        cdir, *lpmap, small, l_small_dens, l_small_pres);
-      // Z|Y
-      CAMR_cmpflx(
-        i, j, k, bclz, bchz, dlz, dhz, qmzy, qpzy, flzy, qzy, qaux,
-        cdir, *lpmap, small, l_small_dens, l_small_pres);
-    });
+  // Z|X
+  CAMR_cmpflx_box(
+    tzfxbx, bclz, bchz, dlz, dhz, qmzx, qpzx, flzx, qzx, qaux,
+    cdir, riemann_type, small, l_small_dens, l_small_pres);
+  // Z|Y
+  CAMR_cmpflx_box(
+    tzfxbx, bclz, bchz, dlz, dhz, qmzy, qpzy, flzy, qzy, qaux,
+    cdir, riemann_type, small, l_small_dens, l_small_pres);
   qzxm.clear();
   qzxp.clear();
   qzym.clear();
@@ -402,10 +405,9 @@ Godunov_umeth (
   gdvzyfab.clear();
 
   // Final X flux
-  amrex::ParallelFor(xfxbx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
-    CAMR_cmpflx(i, j, k, bclx, bchx, dlx, dhx, qm, qp, flx1, q1, qaux,
-              cdir, *lpmap, small, l_small_dens, l_small_pres);
-  });
+  CAMR_cmpflx_box(
+    xfxbx, bclx, bchx, dlx, dhx, qm, qp, flx1, q1, qaux,
+    cdir, riemann_type, small, l_small_dens, l_small_pres);
 
   // Y | X&Z
   cdir = 1;
@@ -424,10 +426,9 @@ Godunov_umeth (
   gdvzxfab.clear();
 
   // Final Y flux
-  amrex::ParallelFor(yfxbx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
-    CAMR_cmpflx(i, j, k, bcly, bchy, dly, dhy, qm, qp, flx2, q2, qaux,
-              cdir, *lpmap, small, l_small_dens, l_small_pres);
-  });
+  CAMR_cmpflx_box(
+    yfxbx, bcly, bchy, dly, dhy, qm, qp, flx2, q2, qaux,
+    cdir, riemann_type, small, l_small_dens, l_small_pres);
 
   // Z | X&Y
   cdir = 2;
@@ -446,17 +447,205 @@ Godunov_umeth (
   gdvyxfab.clear();
 
   // Final Z flux
-  amrex::ParallelFor(zfxbx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
-    CAMR_cmpflx(i, j, k, bclz, bchz, dlz, dhz, qm, qp, flx3, q3, qaux,
-              cdir, *lpmap, small, l_small_dens, l_small_pres);
-  });
+  CAMR_cmpflx_box(
+    zfxbx, bclz, bchz, dlz, dhz, qm, qp, flx3, q3, qaux,
+    cdir, riemann_type, small, l_small_dens, l_small_pres);
   qmfab.clear();
   qpfab.clear();
 
   // Construct p div{U}
+  const amrex::Real volinv = 1.0 / vol;
+  amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
+    CAMR_pdivu(
+      i, j, k, pdivu, AMREX_D_DECL(q1, q2, q3), AMREX_D_DECL(a1, a2, a3), volinv);
+  });
+}
+
+// Strang-split alternative to Godunov_umeth: three one-dimensional sweeps,
+// each tracing and solving one Riemann problem per face from the state left
+// by the previous sweep. The fluxes of each sweep are returned, so the
+// usual conservative update and flux registers see a single flux per face,
+// and pdivu is the sum of the p div u of the sweeps.
+void
+Godunov_umeth_split (
+  amrex::Box const& bx,
+  const int* bclo,
+  const int* bchi,
+  const int* domlo,
+  const int* domhi,
+  amrex::Array4<const amrex::Real> const& u,
+  amrex::Array4<const amrex::Real> const& q,
+  amrex::Array4<const amrex::Real> const& qaux,
+  amrex::Array4<const amrex::Real> const& srcQ,
+  amrex::Array4<amrex::Real> const& flx1,
+  amrex::Array4<amrex::Real> const& flx2,
+  amrex::Array4<amrex::Real> const& flx3,
+  amrex::Array4<amrex::Real> const& q1,
+  amrex::Array4<amrex::Real> const& q2,
+  amrex::Array4<amrex::Real> const& q3,
+  const amrex::Real a1,
+  const amrex::Real a2,
+  const amrex::Real a3,
+  amrex::Array4<amrex::Real> const& pdivu,
+  const amrex::Real vol,
+  const amrex::GpuArray<amrex::Real, AMREX_SPACEDIM> del,
+  const amrex::Real dt,
+  const amrex::Real small,
+  const amrex::Real l_small_dens,
+  const amrex::Real l_small_pres,
+  const int ppm_type,
+  const int use_pslope,
+  const int use_flattening,
+  const int iorder,
+  const int riemann_type,
+  const int sweep_order)
+{
+  BL_PROFILE("CAMR::Godunov_umeth_split()");
+
+  const PassMap* lpmap = CAMR::d_pass_map;
+  const amrex::Real small_num = CAMRConstants::small_num;
+  const amrex::Real dual_energy_eta = CAMR::dual_energy_eta1;
+
+  // x, y, z on even steps and z, y, x on odd ones
+  const int dirs[3] = {(sweep_order == 0) ? 0 : 2, 1, (sweep_order == 0) ? 2 : 0};
+  const amrex::GpuArray<amrex::Array4<amrex::Real>, 3> flx{{flx1, flx2, flx3}};
+  const amrex::GpuArray<amrex::Array4<amrex::Real>, 3> qgdnv{{q1, q2, q3}};
+
+  // A face state needs the reconstruction of the two cells next to it, and
+  // the flattening of those reaches three more cells out, so each sweep
+  // needs the state of the previous one four cells further out along its
+  // direction. Flattening is one-dimensional, along the sweep, so that
+  // nothing outside these regions is read.
+  const int ns = 4;
+  amrex::Box cbx[3];
+  cbx[2] = bx;
+  cbx[1] = amrex::grow(bx, dirs[2], ns);
+  cbx[0] = amrex::grow(cbx[1], dirs[1], ns);
+
+  // Conserved and primitive state between sweeps
+  amrex::FArrayBox us(cbx[0], NVAR, amrex::The_Async_Arena());
+  amrex::FArrayBox qs(cbx[0], QVAR, amrex::The_Async_Arena());
+  amrex::FArrayBox qauxs(cbx[0], NQAUX, amrex::The_Async_Arena());
+  auto const& usarr = us.array();
+  auto const& qsarr = qs.array();
+  auto const& qauxsarr = qauxs.array();
+
+  for (int m = 0; m < 3; ++m) {
+    const int cdir = dirs[m];
+    const amrex::Real dx = del[cdir];
+    const amrex::Box& tbx = amrex::grow(cbx[m], cdir, 1);
+    const amrex::Box& fbx = amrex::surroundingNodes(cbx[m], cdir);
+
+    if (m > 0) {
+      amrex::ParallelFor(
+        amrex::grow(cbx[m], cdir, ns), [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
+          CAMR_ctoprim(i, j, k, usarr, qsarr, qauxsarr, *lpmap, small_num, dual_energy_eta);
+        });
+    }
+    const amrex::Array4<const amrex::Real> qin = (m == 0) ? q : qs.const_array();
+    const amrex::Array4<const amrex::Real> qauxin = (m == 0) ? qaux : qauxs.const_array();
+
+    amrex::FArrayBox flatfab(tbx, 1, amrex::The_Async_Arena());
+    auto const& flatarr = flatfab.array();
+    flatten_box(tbx, qin, flatarr, use_flattening, cdir);
+
+    // Cells traced with PPM in the hybrid reconstruction
+    amrex::IArrayBox ppm_cells_fab;
+    amrex::FArrayBox sensfab;
+    amrex::Array4<int const> ppm_cells;
+    if (ppm_type == 2) {
+      amrex::Array4<const amrex::Real> sens = flatarr;
+      if (use_flattening != 1) {
+        sensfab.resize(tbx, 1, amrex::The_Async_Arena());
+        flatten_box(tbx, qin, sensfab.array(), 1, cdir);
+        sens = sensfab.const_array();
+      }
+      ppm_cells_fab.resize(tbx, 1, amrex::The_Async_Arena());
+      hybrid_ppm_cells(tbx, sens, ppm_cells_fab.array());
+      ppm_cells = ppm_cells_fab.const_array();
+    }
+
+    amrex::FArrayBox qmfab(amrex::growHi(tbx, cdir, 1), QVAR, amrex::The_Async_Arena());
+    amrex::FArrayBox qpfab(tbx, QVAR, amrex::The_Async_Arena());
+    auto const& qm = qmfab.array();
+    auto const& qp = qpfab.array();
+
+    if (ppm_type == 0 || ppm_type == 2) {
+      amrex::ParallelFor(
+        tbx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
+          if (ppm_cells && ppm_cells(i, j, k) != 0) {
+            return;
+          }
+
+          amrex::Real slope[QVAR];
+
+          const amrex::Real flat = flatarr(i, j, k);
+
+          for (int n = 0; n < QVAR; ++n) {
+            if (n == QPRES && use_pslope)
+              slope[n] = plm_pslope(i, j, k, n, cdir, qin, dx, srcQ, flat, iorder);
+            else
+              slope[n] = plm_slope(i, j, k, n, cdir, qin, flat, iorder);
+          }
+          CAMR_plm_d(
+            i, j, k, cdir, qm, qp, slope, qin, qauxin(i, j, k, QC), dx, dt,
+            l_small_dens, l_small_pres, *lpmap);
+        });
+    }
+    if (ppm_type == 1 || ppm_type == 2) {
+      trace_ppm(
+        tbx, cdir, qin, qauxin, srcQ, qm, qp, tbx, dt, del, flatarr,
+        l_small_dens, l_small_pres, lpmap, ppm_cells);
+    }
+
+    amrex::FArrayBox ffab(fbx, NVAR, amrex::The_Async_Arena());
+    amrex::FArrayBox gfab(fbx, NGDNV, amrex::The_Async_Arena());
+    auto const& f = ffab.array();
+    auto const& g = gfab.array();
+    CAMR_cmpflx_box(
+      fbx, bclo[cdir], bchi[cdir], domlo[cdir], domhi[cdir], qm, qp, f, g, qauxin,
+      cdir, riemann_type, small, l_small_dens, l_small_pres);
+
+    // The fluxes of this direction on the faces of bx
+    auto const& flxd = flx[cdir];
+    auto const& qgd = qgdnv[cdir];
+    amrex::ParallelFor(
+      amrex::surroundingNodes(bx, cdir), [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
+        for (int n = 0; n < NVAR; ++n) {
+          flxd(i, j, k, n) = f(i, j, k, n);
+        }
+        for (int n = 0; n < NGDNV; ++n) {
+          qgd(i, j, k, n) = g(i, j, k, n);
+        }
+      });
+
+    // Advance the state by this sweep where the next sweeps need it; the
+    // internal energy also gets the p div u of the sweep
+    if (m < 2) {
+      const amrex::Real dtdx = dt / dx;
+      const int gdu = GDU + cdir;
+      const int di = (cdir == 0);
+      const int dj = (cdir == 1);
+      const int dk = (cdir == 2);
+      const amrex::Array4<const amrex::Real> uin = (m == 0) ? u : us.const_array();
+      amrex::ParallelFor(
+        cbx[m], [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
+          for (int n = 0; n < NVAR; ++n) {
+            usarr(i, j, k, n) = uin(i, j, k, n)
+              - dtdx * (f(i + di, j + dj, k + dk, n) - f(i, j, k, n));
+          }
+          usarr(i, j, k, UEINT) -= dtdx * 0.5
+            * (g(i + di, j + dj, k + dk, GDPRES) + g(i, j, k, GDPRES))
+            * (g(i + di, j + dj, k + dk, gdu) - g(i, j, k, gdu));
+        });
+    }
+  }
+
+  // Construct p div{U}
+  const amrex::Real volinv = 1.0 / vol;
   amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
     CAMR_pdivu(
-      i, j, k, pdivu, AMREX_D_DECL(q1, q2, q3), AMREX_D_DECL(a1, a2, a3), vol);
+      i, j, k, pdivu, AMREX_D_DECL(q1, q2, q3), AMREX_D_DECL(a1, a2, a3), volinv);
   });
 }
 
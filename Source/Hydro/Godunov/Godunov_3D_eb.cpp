@@ -28,6 +28,7 @@ Godunov_umeth_eb (
   amrex::Array4<const amrex::Real> const& a2,
   amrex::Array4<const amrex::Real> const& a3,
   amrex::Array4<amrex::Real> const& pdivu,
+  const amrex::Real vol,
   amrex::Array4<const amrex::Real> const& /*vfrac*/,
   amrex::Array4<amrex::EBCellFlag const> const& flag_arr,
   const amrex::GpuArray<amrex::Real, AMREX_SPACEDIM> del,
@@ -39,7 +40,8 @@ Godunov_umeth_eb (
   const int use_pslope,
   const int use_flattening,
   const int iorder,
-  const int l_transverse_reset_density)
+  const int l_transverse_reset_density,
+  const int riemann_type)
 {
   BL_PROFILE("CAMR::Godunov_umeth_3D_eb()");
 
@@ -100,21 +102,46 @@ Godunov_umeth_eb (
 
   const PassMap* lpmap = CAMR::d_pass_map;
 
+  // Flattening coefficient of each cell, shared by the traces of all the
+  // directions; PLM uses the EB-aware one
+  amrex::FArrayBox flatfab(bxg2, 1, amrex::The_Async_Arena());
+  auto const& flatarr = flatfab.array();
+  if (ppm_type != 1) {
+    flatten_box_eb(bxg2, flag_arr, q, flatarr, use_flattening);
+  } else {
+    flatten_box(bxg2, q, flatarr, use_flattening);
+  }
+
+  // In the hybrid reconstruction (ppm_type = 2) only the cells near shocks
+  // are traced with PPM, and the rest with PLM
+  amrex::IArrayBox ppm_cells_fab;
+  amrex::FArrayBox sensfab;
+  amrex::Array4<int const> ppm_cells;
+  if (ppm_type == 2) {
+    amrex::Array4<const amrex::Real> sens = flatarr;
+    if (use_flattening != 1) {
+      sensfab.resize(bxg2, 1, amrex::The_Async_Arena());
+      flatten_box(bxg2, q, sensfab.array(), 1);
+      sens = sensfab.const_array();
+    }
+    ppm_cells_fab.resize(bxg2, 1, amrex::The_Async_Arena());
+    hybrid_ppm_cells(bxg2, sens, ppm_cells_fab.array());
+    ppm_cells = ppm_cells_fab.const_array();
+  }
+
   // Put the PLM and slopes in the same kernel launch to avoid unnecessary
   // launch overhead
-  if (ppm_type == 0) {
+  if (ppm_type == 0 || ppm_type == 2) {
     amrex::ParallelFor(
       bxg2, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
         amrex::Real slope[QVAR];
 
-        amrex::Real flat = 1.0;
-        // Calculate flattening in-place
-        if (use_flattening == 1) {
-           for (int dir_flat = 0; dir_flat < AMREX_SPACEDIM; dir_flat++) {
-             flat = std::min(flat, flatten_eb(i, j, k, dir_flat, flag_arr, q));
-          }
+        if (ppm_cells && ppm_cells(i, j, k) != 0) {
+          return;
         }
 
+        const amrex::Real flat = flatarr(i, j, k);
+
         // X slopes and interp
         int idir = 0;
         for (int n = 0; n < QVAR; ++n) {
@@ -151,7 +178,8 @@ Godunov_umeth_eb (
           i, j, k, idir, qzmarr, qzparr, slope, q, qaux(i, j, k, QC), dz, dt,
           l_small_dens, l_small_pres, *lpmap, a3);
       });
-  } else if (ppm_type == 1) {
+  }
+  if (ppm_type == 1 || ppm_type == 2) {
     // Compute the normal interface states by reconstructing
     // the primitive variables using the piecewise parabolic method
     // and doing characteristic tracing.  We do not apply the
@@ -159,21 +187,18 @@ Godunov_umeth_eb (
 
     int idir = 0;
     trace_ppm(
-      bxg2, idir, q, qaux, srcQ, qxmarr, qxparr, bxg2, dt, del, use_flattening,
-      l_small_dens, l_small_pres, lpmap);
+      bxg2, idir, q, qaux, srcQ, qxmarr, qxparr, bxg2, dt, del, flatarr,
+      l_small_dens, l_small_pres, lpmap, ppm_cells);
 
     idir = 1;
     trace_ppm(
-      bxg2, idir, q, qaux, srcQ, qymarr, qyparr, bxg2, dt, del, use_flattening,
-      l_small_dens, l_small_pres, lpmap);
+      bxg2, idir, q, qaux, srcQ, qymarr, qyparr, bxg2, dt, del, flatarr,
+      l_small_dens, l_small_pres, lpmap, ppm_cells);
 
     idir = 2;
     trace_ppm(
-      bxg2, idir, q, qaux, srcQ, qzmarr, qzparr, bxg2, dt, del, use_flattening,
-      l_small_dens, l_small_pres, lpmap);
-
-  } else {
-    amrex::Error("CAMR::ppm_type must be 0 (PLM) or 1 (PPM)");
+      bxg2, idir, q, qaux, srcQ, qzmarr, qzparr, bxg2, dt, del, flatarr,
+      l_small_dens, l_small_pres, lpmap, ppm_cells);
   }
 
   // These are the first flux estimates as per the corner-transport-upwind
@@ -187,7 +212,7 @@ Godunov_umeth_eb (
     xflxbx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
       CAMR_cmpflx(
         i, j, k, bclx, bchx, dlx, dhx, qxmarr, qxparr, fxarr, gdtempx, qaux,
-        cdir, *lpmap, small, l_small_dens, l_small_pres);
+        cdir, riemann_type, small, l_small_dens, l_small_pres);
     });
 
   // Y initial fluxes
@@ -200,7 +225,7 @@ Godunov_umeth_eb (
     yflxbx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
       CAMR_cmpflx(
         i, j, k, bcly, bchy, dly, dhy, qymarr, qyparr, fyarr, gdtempy, qaux,
-        cdir, *lpmap, small, l_small_dens, l_small_pres);
+        cdir, riemann_type, small, l_small_dens, l_small_pres);
     });
 
   // Z initial fluxes
@@ -213,7 +238,7 @@ Godunov_umeth_eb (
     zflxbx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
       CAMR_cmpflx(
         i, j, k, bclz, bchz, dlz, dhz, qzmarr, qzparr, fzarr, gdtempz, qaux,
-        cdir, *lpmap, small, l_small_dens, l_small_pres);
+        cdir, riemann_type, small, l_small_dens, l_small_pres);
     });
 
   // X interface corrections
@@ -258,11 +283,11 @@ Godunov_umeth_eb (
       // X|Y
       CAMR_cmpflx(
         i, j, k, bclx, bchx, dlx, dhx, qmxy, qpxy, flxy, qxy, qaux,
-        cdir, *lpmap, small, l_small_dens, l_small_pres);
+        cdir, riemann_type, small, l_small_dens, l_small_pres);
       // X|Z
       CAMR_cmpflx(
         i, j, k, bclx, bchx, dlx, dhx, qmxz, qpxz, flxz, qxz, qaux,
-        cdir, *lpmap, small, l_small_dens, l_small_pres);
+        cdir, riemann_type, small, l_small_dens, l_small_pres);
     });
   qxym.clear();
   qxyp.clear();
@@ -312,11 +337,11 @@ Godunov_umeth_eb (
       // Y|X
       CAMR_cmpflx(
         i, j, k, bcly, bchy, dly, dhy, qmyx, qpyx, flyx, qyx, qaux,
-        cdir, *lpmap, small, l_small_dens, l_small_pres);
+        cdir, riemann_type, small, l_small_dens, l_small_pres);
       // Y|Z
       CAMR_cmpflx(
         i, j, k, bcly, bchy, dly, dhy, qmyz, qpyz, flyz, qyz, qaux,
-        cdir, *lpmap, small, l_small_dens, l_small_pres);
+        cdir, riemann_type, small, l_small_dens, l_small_pres);
     });
   qyxm.clear();
   qyxp.clear();
@@ -369,11 +394,11 @@ Godunov_umeth_eb (
       // Z|X
       CAMR_cmpflx(
         i, j, k, bclz, bchz, dlz, dhz, qmzx, qpzx, flzx, qzx, qaux,
-        cdir, *lpmap, small, l_small_dens, l_small_pres);
+        cdir, riemann_type, small, l_small_dens, l_small_pres);
       // Z|Y
       CAMR_cmpflx(
         i, j, k, bclz, bchz, dlz, dhz, qmzy, qpzy, flzy, qzy, qaux,
-        cdir, *lpmap, small, l_small_dens, l_small_pres);
+        cdir, riemann_type, small, l_small_dens, l_small_pres);
     });
   qzxm.clear();
   qzxp.clear();
@@ -405,7 +430,7 @@ Godunov_umeth_eb (
   // Final X flux
   amrex::ParallelFor(xfxbx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
     CAMR_cmpflx(i, j, k, bclx, bchx, dlx, dhx, qm, qp, flx1, q1, qaux,
-              cdir, *lpmap, small, l_small_dens, l_small_pres);
+              cdir, riemann_type, small, l_small_dens, l_small_pres);
   });
 
   // Y | X&Z
@@ -427,7 +452,7 @@ Godunov_umeth_eb (
   // Final Y flux
   amrex::ParallelFor(yfxbx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
     CAMR_cmpflx(i, j, k, bcly, bchy, dly, dhy, qm, qp, flx2, q2, qaux,
-              cdir, *lpmap, small, l_small_dens, l_small_pres);
+              cdir, riemann_type, small, l_small_dens, l_small_pres);
   });
 
   // Z | X&Y
@@ -449,15 +474,19 @@ Godunov_umeth_eb (
   // Final Z flux
   amrex::ParallelFor(zfxbx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
     CAMR_cmpflx(i, j, k, bclz, bchz, dlz, dhz, qm, qp, flx3, q3, qaux,
-              cdir, *lpmap, small, l_small_dens, l_small_pres);
+              cdir, riemann_type, small, l_small_dens, l_small_pres);
   });
   qmfab.clear();
   qpfab.clear();
 
-  // Construct p div{U}
+  // Construct p div{U}; only regular cells, which have full face areas
+  const amrex::Real volinv = 1.0 / vol;
+  const amrex::Real ax = dy * dz;
+  const amrex::Real ay = dx * dz;
+  const amrex::Real az = dx * dy;
   amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
       if (flag_arr(i,j,k).isRegular()) {
-          CAMR_pdivu(i, j, k, pdivu, q1, q2, a1, a2, vol);
+          CAMR_pdivu(i, j, k, pdivu, q1, q2, q3, ax, ay, az, volinv);
       } else {
           pdivu(i,j,k) = Real(0.0);
       }
@@ -4,7 +4,6 @@
 #elif (AMREX_SPACEDIM == 3)
 #include "Godunov_utils_3D.H"
 #endif
-#include "flatten.H"
 #include "PPM.H"
 
 void
@@ -19,10 +18,11 @@ trace_ppm(
   const amrex::Box& vbx,
   const amrex::Real dt,
   const amrex::GpuArray<amrex::Real, AMREX_SPACEDIM> dx,
-  const int use_flattening,
+  amrex::Array4<amrex::Real const> const& flat_arr,
   const amrex::Real small_dens,
   const amrex::Real small_pres,
-  PassMap const* pmap)
+  PassMap const* pmap,
+  amrex::Array4<int const> const& ppm_cells)
 {
   // here, lo and hi are the range we loop over -- this can include ghost cells
   // vlo and vhi are the bounds of the valid box (no ghost cells)
@@ -97,10 +97,14 @@ trace_ppm(
   }
 #endif
 
-  // Trace to left and right edges using upwind PPM
+  // Trace to left and right edges using upwind PPM, only in the cells
+  // flagged in ppm_cells if it is given
   amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept
   {
     const amrex::IntVect iv{AMREX_D_DECL(i, j, k)};
+    if (ppm_cells && ppm_cells(iv) == 0) {
+      return;
+    }
     const amrex::IntVect ivm2(
       iv - 2 * amrex::IntVect::TheDimensionVector(idir));
     const amrex::IntVect ivm1(
@@ -117,13 +121,7 @@ trace_ppm(
     // do the parabolic reconstruction and compute the
     // integrals under the characteristic waves
 
-    amrex::Real flat = 1.0;
-    // Calculate flattening in-place
-    if (use_flattening == 1) {
-      for (int dir_flat = 0; dir_flat < AMREX_SPACEDIM; dir_flat++) {
-        flat = std::min(flat, flatten(i, j, k, dir_flat, q_arr));
-      }
-    }
+    const amrex::Real flat = flat_arr(iv);
 
     amrex::Real Ip[QVAR+1][3];
     amrex::Real Im[QVAR+1][3];
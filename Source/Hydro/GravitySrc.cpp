@@ -67,11 +67,11 @@ CAMR::fill_grav_source (const amrex::MultiFab& S,
     amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
 
 #if (AMREX_SPACEDIM == 2)
-      src(i, j, k, UMY  ) = l_const_grav * s(i,j,k,URHO);  // rho g
-      src(i, j, k, UEDEN) = l_const_grav * s(i,j,k,UMY);   // rho u g
+      src(i, j, k, 0) = l_const_grav * s(i,j,k,URHO);  // rho g   -> UMY
+      src(i, j, k, 1) = l_const_grav * s(i,j,k,UMY);   // rho u g -> UEDEN
 #else
-      src(i, j, k, UMZ  ) = l_const_grav * s(i,j,k,URHO);  // rho g
-      src(i, j, k, UEDEN) = l_const_grav * s(i,j,k,UMZ);   // rho u g
+      src(i, j, k, 0) = l_const_grav * s(i,j,k,URHO);  // rho g   -> UMZ
+      src(i, j, k, 1) = l_const_grav * s(i,j,k,UMZ);   // rho u g -> UEDEN
 #endif
     });
   }
@@ -114,11 +114,11 @@ CAMR::fill_gravcorr_source(
     amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
 
 #if (AMREX_SPACEDIM == 2)
-      src(i, j, k, UMY  ) = 0.5 * l_const_grav * (snew(i,j,k,URHO) - sold(i,j,k,URHO));  // rho g
-      src(i, j, k, UEDEN) = 0.5 * l_const_grav * (snew(i,j,k,UMY ) - sold(i,j,k,UMY ));  // rho u g
+      src(i, j, k, 0) = 0.5 * l_const_grav * (snew(i,j,k,URHO) - sold(i,j,k,URHO));  // rho g   -> UMY
+      src(i, j, k, 1) = 0.5 * l_const_grav * (snew(i,j,k,UMY ) - sold(i,j,k,UMY ));  // rho u g -> UEDEN
 #else
-      src(i, j, k, UMZ  ) = 0.5 * l_const_grav * (snew(i,j,k,URHO) - sold(i,j,k,URHO));  // rho g
-      src(i, j, k, UEDEN) = 0.5 * l_const_grav * (snew(i,j,k,UMZ ) - sold(i,j,k,UMZ ));  // rho u g
+      src(i, j, k, 0) = 0.5 * l_const_grav * (snew(i,j,k,URHO) - sold(i,j,k,URHO));  // rho g   -> UMZ
+      src(i, j, k, 1) = 0.5 * l_const_grav * (snew(i,j,k,UMZ ) - sold(i,j,k,UMZ ));  // rho u g -> UEDEN
 #endif
     });
   }
@@ -25,15 +25,16 @@ MOL_umeth (const Box& bx,
            AMREX_D_DECL(Array4<Real> const& q1,
                         Array4<Real> const& q2,
                         Array4<Real> const& q3),
-           AMREX_D_DECL(Array4<const Real> const& a1,
-                        Array4<const Real> const& a2,
-                        Array4<const Real> const& a3),
+           AMREX_D_DECL(const Real a1,
+                        const Real a2,
+                        const Real a3),
            Array4<Real> const& pdivu,
-           Array4<const Real> const& vol,
+           const Real vol,
            const amrex::Real small,
            const amrex::Real small_dens,
            const amrex::Real small_pres,
-           const int iorder)
+           const int iorder,
+           const int riemann_type)
 {
     BL_PROFILE("CAMR::MOL_umeth()");
 
@@ -58,8 +59,6 @@ MOL_umeth (const Box& bx,
 
 //    amrex::Real slope[QVAR]
 
-    const PassMap* lpmap = CAMR::d_pass_map;
-
     Real l_plm_theta = 2.0; // [1,2] 1: minmod; 2: van Leer's MC
 
     // x-direction
@@ -83,9 +82,10 @@ MOL_umeth (const Box& bx,
     amrex::ParallelFor(xflxbx,
     [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
     {
-        mol_riemann_x(i, j, k, fx, slope, q, qa, q1, qxmarr, qxparr, small, small_dens, small_pres,
-                      bclx, bchx, dlx, dhx, *lpmap);
+        mol_states_x(i, j, k, slope, q, qa, qxmarr, qxparr, small_dens, small_pres);
     });
+    CAMR_cmpflx_box(xflxbx, bclx, bchx, dlx, dhx, qxmarr, qxparr, fx, q1, qa,
+                    cdir, riemann_type, small, small_dens, small_pres);
 
     // y-direction
     cdir = 1;
@@ -105,9 +105,10 @@ MOL_umeth (const Box& bx,
     amrex::ParallelFor(yflxbx,
     [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
     {
-        mol_riemann_y(i, j, k, fy, slope, q, qa, q2, qymarr, qyparr, small, small_dens, small_pres,
-                      bcly, bchy, dly, dhy, *lpmap);
+        mol_states_y(i, j, k, slope, q, qa, qymarr, qyparr, small_dens, small_pres);
     });
+    CAMR_cmpflx_box(yflxbx, bcly, bchy, dly, dhy, qymarr, qyparr, fy, q2, qa,
+                    cdir, riemann_type, small, small_dens, small_pres);
 
 #if (AMREX_SPACEDIM == 3)
 
@@ -129,15 +130,17 @@ MOL_umeth (const Box& bx,
     amrex::ParallelFor(zflxbx,
     [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
     {
-        mol_riemann_z(i, j, k, fz, slope, q, qa, q3, qzmarr, qzparr, small, small_dens, small_pres,
-                      bclz, bchz, dlz, dhz, *lpmap);
+        mol_states_z(i, j, k, slope, q, qa, qzmarr, qzparr, small_dens, small_pres);
     });
+    CAMR_cmpflx_box(zflxbx, bclz, bchz, dlz, dhz, qzmarr, qzparr, fz, q3, qa,
+                    cdir, riemann_type, small, small_dens, small_pres);
 
 #endif
 
    // Construct p div{U}
+   const Real volinv = 1.0 / vol;
    amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
-     CAMR_pdivu(i, j, k, pdivu, AMREX_D_DECL(q1, q2, q3), AMREX_D_DECL(a1, a2, a3), vol);
+     CAMR_pdivu(i, j, k, pdivu, AMREX_D_DECL(q1, q2, q3), AMREX_D_DECL(a1, a2, a3), volinv);
    });
 
    Gpu::streamSynchronize();
@@ -36,6 +36,7 @@ MOL_umeth_eb (const Box& /*bx*/,
               const amrex::Real small_dens,
               const amrex::Real small_pres,
               const int l_plm_iorder,
+              const int riemann_type,
               const int /*l_eb_weights_type*/)
 {
     BL_PROFILE("MOL_umeth_eb()");
@@ -53,8 +54,6 @@ MOL_umeth_eb (const Box& /*bx*/,
                  const int dhy = domhi[1];,
                  const int dhz = domhi[2];);
 
-    const PassMap* lpmap = CAMR::d_pass_map;
-
     Real l_plm_theta = 2.0; // [1,2] 1: minmod; 2: van Leer's MC
 
     const Box& bxg_i  = Box(divc_arr);
@@ -100,7 +99,7 @@ MOL_umeth_eb (const Box& /*bx*/,
     {
         if (flag(i,j,k).isConnected(-1,0,0)) {
             mol_riemann_x(i, j, k, fx_arr, slope, q_arr, qaux_arr, q1, qxmarr, qxparr, small, small_dens, small_pres,
-                          bclx, bchx, dlx, dhx, *lpmap);
+                          bclx, bchx, dlx, dhx, riemann_type);
         } else {
            for (int n = 0; n < NGDNV; n++) {
                q1(i,j,k,n) = 0.;
@@ -135,7 +134,7 @@ MOL_umeth_eb (const Box& /*bx*/,
     {
         if (flag(i,j,k).isConnected(0,-1,0)) {
             mol_riemann_y(i, j, k, fy_arr, slope, q_arr, qaux_arr, q2, qymarr, qyparr, small, small_dens, small_pres,
-                          bcly, bchy, dly, dhy, *lpmap);
+                          bcly, bchy, dly, dhy, riemann_type);
         } else {
            for (int n = 0; n < NGDNV; n++) {
                q2(i,j,k,n) = 0.;
@@ -171,7 +170,7 @@ MOL_umeth_eb (const Box& /*bx*/,
         if (flag(i,j,k).isConnected(0,0,-1))
         {
             mol_riemann_z(i, j, k, fz_arr, slope, q_arr, qaux_arr, q3, qzmarr, qzparr, small, small_dens, small_pres,
-                          bclz, bchz, dlz, dhz, *lpmap);
+                          bclz, bchz, dlz, dhz, riemann_type);
         } else {
            for (int n = 0; n < NGDNV; n++) {
                q3(i,j,k,n) = 0.;
@@ -149,3 +149,58 @@ CAMR::errorEst (TagBoxArray& tags,
     errtags[j](tags,mf.get(),char(clearval),char(tagval),time,level,geom);
   }
 }
+
+void
+CAMR::manual_tags_placement (TagBoxArray& tags,
+                             const Vector<IntVect>& /*bf_lev*/)
+{
+#ifdef AMREX_USE_EB
+    if (!eb_prune_covered) {
+        return;
+    }
+
+    const auto& ebfactory = dynamic_cast<amrex::EBFArrayBoxFactory const&>(Factory());
+    if (ebfactory.isAllRegular()) {
+        return;
+    }
+
+    // A tag is dropped when every cell within this distance is covered. The
+    // distance spans the fine ghost cells, so the fine grids still hold the
+    // full hydro stencil of every cut cell; the rest of the body is left to
+    // the coarse level and to FillPatch.
+    const int rr = parent->refRatio(level).max();
+    const int nprune = (numGrow() + rr - 1) / rr + 1;
+
+    const auto& flags = ebfactory.getMultiEBCellFlagFab();
+
+    for (MFIter mfi(tags); mfi.isValid(); ++mfi)
+    {
+        const EBCellFlagFab& flagfab = flags[mfi];
+        const Box fbx = flagfab.box();
+        const Box bx = tags[mfi].box() & amrex::grow(fbx, -nprune);
+        if (bx.isEmpty() || flagfab.getType(amrex::grow(bx, nprune)) == FabType::regular) {
+            continue;
+        }
+
+        auto const& tagarr = tags.array(mfi);
+        auto const& flag = flagfab.const_array();
+        ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            if (tagarr(i,j,k) == TagBox::CLEAR) {
+                return;
+            }
+            bool all_covered = true;
+            for (int kk = -nprune*AMREX_D_PICK(0,0,1); kk <= nprune*AMREX_D_PICK(0,0,1); ++kk) {
+            for (int jj = -nprune*AMREX_D_PICK(0,1,1); jj <= nprune*AMREX_D_PICK(0,1,1); ++jj) {
+            for (int ii = -nprune; ii <= nprune; ++ii) {
+                all_covered = all_covered && flag(i+ii,j+jj,k+kk).isCovered();
+            }}}
+            if (all_covered) {
+                tagarr(i,j,k) = TagBox::CLEAR;
+            }
+        });
+    }
+#else
+    amrex::ignore_unused(tags);
+#endif
+}
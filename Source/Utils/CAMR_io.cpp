@@ -39,6 +39,21 @@ CAMR::restart(amrex::Amr& papa, std::istream& is, bool bReadSpecial)
 
     amrex::Print() << "read CPU time: " << previousCPUTimeUsed << "\n";
   }
+
+  // The steady_tol reference of this level; checkpoints written before it
+  // was stored restart with a fresh reference
+  if (amrex::ParallelDescriptor::IOProcessor()) {
+    std::ifstream RefFile(parent->theRestartFile() + "/" +
+                          amrex::Concatenate("Level_", level, 1) + "/ResidualRef");
+    if (RefFile >> residual_ref) {
+      amrex::Print() << "read residual reference of level " << level << ": "
+                     << residual_ref << "\n";
+    } else {
+      residual_ref = 0.0;
+    }
+  }
+  amrex::ParallelDescriptor::Bcast(&residual_ref, 1,
+                                   amrex::ParallelDescriptor::IOProcessorNumber());
 }
 
 void
@@ -50,6 +65,13 @@ CAMR::checkPoint(
 {
   amrex::AmrLevel::checkPoint(dir, os, how, dump_old);
 
+  if (amrex::ParallelDescriptor::IOProcessor()) {
+    // store the steady_tol reference of this level
+    std::ofstream RefFile(dir + "/" + amrex::Concatenate("Level_", level, 1) +
+                          "/ResidualRef");
+    RefFile << std::setprecision(17) << residual_ref;
+  }
+
   if (level == 0 && amrex::ParallelDescriptor::IOProcessor()) {
     {
       // store elapsed CPU time
@@ -1,6 +1,7 @@
 #include <AMReX_ParmParse.H>
 #include <AMReX_buildInfo.H>
 #include <memory>
+#include <numeric>
 
 #include "CAMR.H"
 #include "Derive.H"
@@ -177,11 +178,22 @@ CAMR::variableSetUp()
   }
   */
 
-  // Get the species names
+  // Get the species names from the build-time table
   spec_names.resize(NUM_SPECIES);
-  spec_names[0] = "F";
-  spec_names[1] = "A";
-  spec_names[2] = "P";
+#if (NUM_SPECIES > 0)
+#ifdef CAMR_SPECIES_NAMES
+  const char* spec_table[] = {CAMR_SPECIES_NAMES};
+  static_assert(sizeof(spec_table) / sizeof(spec_table[0]) == NUM_SPECIES,
+                "CAMR_SPECIES_NAMES must list NUM_SPECIES names");
+  for (int i = 0; i < NUM_SPECIES; ++i) {
+    spec_names[i] = spec_table[i];
+  }
+#else
+  for (int i = 0; i < NUM_SPECIES; ++i) {
+    spec_names[i] = "S" + std::to_string(i);
+  }
+#endif
+#endif
 
   if (amrex::ParallelDescriptor::IOProcessor()) {
     amrex::Print() << NUM_SPECIES << " Species: " << std::endl;
@@ -264,18 +276,12 @@ CAMR::variableSetUp()
   //
   // X from rhoX
   //
-  std::string spec_string_F = "X(F)";
-  derive_lst.add(spec_string_F,amrex::IndexType::TheCellType(),1,CAMR_derspec,the_same_box);
-  derive_lst.addComponent(spec_string_F,desc_lst,State_Type,URHO,1);
-  derive_lst.addComponent(spec_string_F,desc_lst,State_Type,UFS,1);
-  std::string spec_string_A = "X(A)";
-  derive_lst.add(spec_string_A,amrex::IndexType::TheCellType(),1,CAMR_derspec,the_same_box);
-  derive_lst.addComponent(spec_string_A,desc_lst,State_Type,URHO,1);
-  derive_lst.addComponent(spec_string_A,desc_lst,State_Type,UFS+1,1);
-  std::string spec_string_P = "X(P)";
-  derive_lst.add(spec_string_P,amrex::IndexType::TheCellType(),1,CAMR_derspec,the_same_box);
-  derive_lst.addComponent(spec_string_P,desc_lst,State_Type,URHO,1);
-  derive_lst.addComponent(spec_string_P,desc_lst,State_Type,UFS+2,1);
+  for (int i = 0; i < NUM_SPECIES; ++i) {
+    const std::string spec_string = "X(" + spec_names[i] + ")";
+    derive_lst.add(spec_string,amrex::IndexType::TheCellType(),1,CAMR_derspec,the_same_box);
+    derive_lst.addComponent(spec_string,desc_lst,State_Type,URHO,1);
+    derive_lst.addComponent(spec_string,desc_lst,State_Type,UFS+i,1);
+  }
 
   // Velocities
   derive_lst.add("x_velocity", amrex::IndexType::TheCellType(), 1, CAMR_dervelx, the_same_box);
@@ -333,13 +339,35 @@ CAMR::variableCleanUp()
 void
 CAMR::set_active_sources()
 {
-  // optional external source
+  src_comps.resize(num_src);
+
+  // optional external source; the user hook may write any component
   if (add_ext_src == 1) {
     src_list.push_back(ext_src);
+    src_comps[ext_src].resize(NVAR);
+    std::iota(src_comps[ext_src].begin(), src_comps[ext_src].end(), 0);
   }
 
-  // optional gravity source
+  // optional gravity source: momentum along gravity and total energy
   if (add_grav_src == 1) {
     src_list.push_back(grav_src);
+#if (AMREX_SPACEDIM == 2)
+    src_comps[grav_src] = {UMY, UEDEN};
+#else
+    src_comps[grav_src] = {UMZ, UEDEN};
+#endif
+  }
+}
+
+amrex::GpuArray<int, NVAR>
+CAMR::src_slots(int src)
+{
+  amrex::GpuArray<int, NVAR> slots;
+  for (int n = 0; n < NVAR; ++n) {
+    slots[n] = -1;
+  }
+  for (int m = 0; m < src_comps[src].size(); ++m) {
+    slots[src_comps[src][m]] = m;
   }
+  return slots;
 }
@@ -595,7 +595,7 @@ CAMR_dersoundspeed(
 #endif
     {
     const amrex::Real rhoInv = 1.0 / rho;
-    amrex::Real massfrac[NUM_SPECIES];
+    amrex::Real massfrac[NUM_SPECIES_ARR];
     amrex::Real c;
     for (int n = 0; n < NUM_SPECIES; ++n) {
       massfrac[n] = dat(i, j, k, UFS + n) * rhoInv;
@@ -635,7 +635,7 @@ CAMR_dermachnumber(
 #endif
     {
     const amrex::Real rhoInv = 1.0 / rho;
-    amrex::Real massfrac[NUM_SPECIES];
+    amrex::Real massfrac[NUM_SPECIES_ARR];
     amrex::Real c;
     for (int n = 0; n < NUM_SPECIES; ++n) {
       massfrac[n] = dat(i, j, k, UFS + n) * rhoInv;
@@ -684,7 +684,7 @@ CAMR_derpres(
     const amrex::Real rhoInv = 1.0 / rho;
     amrex::Real e = dat(i, j, k, UEINT) * rhoInv;
     amrex::Real p;
-    amrex::Real massfrac[NUM_SPECIES];
+    amrex::Real massfrac[NUM_SPECIES_ARR];
     for (int n = 0; n < NUM_SPECIES; ++n) {
       massfrac[n] = dat(i, j, k, UFS + n) * rhoInv;
     }
@@ -737,7 +737,7 @@ CAMR_dercp(
     } else
 #endif
     {
-    amrex::Real mass[NUM_SPECIES];
+    amrex::Real mass[NUM_SPECIES_ARR];
     const amrex::Real rhoInv = 1.0 / dat(i, j, k, URHO);
 
     for (int n = 0; n < NUM_SPECIES; n++) {
@@ -76,7 +76,7 @@ CAMR::fill_ext_source(
 
     // Evaluate the external source
     amrex::ParallelFor(
-      bx, NVAR, [=] AMREX_GPU_DEVICE(int i, int j, int k, int n) noexcept {
+      bx, ext_src.nComp(), [=] AMREX_GPU_DEVICE(int i, int j, int k, int n) noexcept {
         Farr(i, j, k, n) = 0.0;
       });
   }
@@ -55,7 +55,7 @@ CAMR::volWgtSum(
   amrex::MultiFab::Multiply(*mf, *volfrac, 0, 0, 1, 0);
 #endif
 
-  sum = amrex::MultiFab::Dot(*mf, 0, volume, 0, 1, 0, local);
+  sum = mf->sum(0, local) * Volume();
 
   if (!local) {
     amrex::ParallelDescriptor::ReduceRealSum(sum);
@@ -81,14 +81,11 @@ CAMR::volWgtSquaredSum(const std::string& name, amrex::Real time, bool local)
 
   amrex::MultiFab::Multiply(*mf, *mf, 0, 0, 1, 0);
 
-  amrex::MultiFab vol(grids, dmap, 1, 0);
-  amrex::MultiFab::Copy(vol, volume, 0, 0, 1, 0);
-
 #ifdef AMREX_USE_EB
   amrex::MultiFab::Multiply(*mf, *volfrac, 0, 0, 1, 0);
 #endif
 
-  sum = amrex::MultiFab::Dot(*mf, 0, vol, 0, 1, 0, local);
+  sum = mf->sum(0, local) * Volume();
 
   if (!local) {
     amrex::ParallelDescriptor::ReduceRealSum(sum);
@@ -119,12 +116,10 @@ CAMR ::volWgtSquaredSumDiff(int comp, amrex::Real /*time*/, bool local)
 
   amrex::MultiFab::Multiply(diff, diff, 0, 0, 1, 0);
 
-  amrex::MultiFab vol(grids, dmap, 1, 0);
-  amrex::MultiFab::Copy(vol, volume, 0, 0, 1, 0);
 #ifdef AMREX_USE_EB
-  amrex::MultiFab::Multiply(vol, *volfrac, 0, 0, 1, 0);
+  amrex::MultiFab::Multiply(diff, *volfrac, 0, 0, 1, 0);
 #endif
-  sum = amrex::MultiFab::Dot(diff, 0, vol, 0, 1, 0, local);
+  sum = diff.sum(0, local) * Volume();
 
   if (!local) {
     amrex::ParallelDescriptor::ReduceRealSum(sum);
@@ -152,7 +147,7 @@ CAMR::volWgtSumMF(
   amrex::MultiFab::Multiply(vol, *volfrac, 0, 0, 1, 0);
 #endif
 
-  sum = amrex::MultiFab::Dot(vol, 0, volume, 0, 1, 0, local);
+  sum = vol.sum(0, local) * Volume();
 
   if (!local) {
     amrex::ParallelDescriptor::ReduceRealSum(sum);